@@ -0,0 +1,71 @@
+#pragma once
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "flat_table.h"
+
+// Mapa y conjunto de coordenadas (x, y) para los problemas de rejillas, sobre
+// FlatTable. Las dos coordenadas se empaquetan en una clave de 64 bits que se
+// mezcla con mix64, así que celdas vecinas no colisionan como con x ^ (y << 1).
+
+inline uint64_t pack_coord(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+inline int unpack_x(uint64_t key) { return static_cast<int>(static_cast<uint32_t>(key >> 32)); }
+inline int unpack_y(uint64_t key) { return static_cast<int>(static_cast<uint32_t>(key)); }
+
+template <typename Value>
+class FlatCoordMap {
+public:
+    explicit FlatCoordMap(size_t expected = 16) : table_(expected) {}
+
+    size_t size() const { return table_.size(); }
+    bool empty() const { return table_.empty(); }
+    void reserve(size_t expected) { table_.reserve(expected); }
+    void clear() { table_.clear(); }
+
+    // Valor de (x, y), creándolo con Value() si no existía.
+    Value& operator()(int x, int y) { return insert(x, y).first; }
+
+    // Inserta (x, y) si no estaba. Devuelve el valor y si se ha creado.
+    std::pair<Value&, bool> insert(int x, int y, const Value& value = Value()) {
+        return table_.insert(pack_coord(x, y), value);
+    }
+
+    Value* find(int x, int y) { return table_.find(pack_coord(x, y)); }
+    const Value* find(int x, int y) const { return table_.find(pack_coord(x, y)); }
+    bool contains(int x, int y) const { return table_.contains(pack_coord(x, y)); }
+    bool erase(int x, int y) { return table_.erase(pack_coord(x, y)); }
+
+    // Llama a visit(x, y, valor) para cada elemento.
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        table_.for_each([&](uint64_t key, const Value& value) { visit(unpack_x(key), unpack_y(key), value); });
+    }
+
+private:
+    FlatTable<uint64_t, Value> table_;
+};
+
+// Conjunto de coordenadas sobre el mismo esquema.
+class FlatCoordSet {
+public:
+    explicit FlatCoordSet(size_t expected = 16) : map_(expected) {}
+
+    // Devuelve true si (x, y) no estaba.
+    bool insert(int x, int y) { return map_.insert(x, y).second; }
+    bool contains(int x, int y) const { return map_.contains(x, y); }
+    bool erase(int x, int y) { return map_.erase(x, y); }
+    size_t size() const { return map_.size(); }
+    void reserve(size_t expected) { map_.reserve(expected); }
+    void clear() { map_.clear(); }
+
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        map_.for_each([&](int x, int y, char) { visit(x, y); });
+    }
+
+private:
+    FlatCoordMap<char> map_;
+};
@@ -0,0 +1,237 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Tabla hash plana con direccionamiento abierto, base de FlatCoordMap y de las
+// tablas por valor del día 11. Claves, valores e indicadores de ocupación van
+// en tres arrays contiguos de capacidad potencia de dos, con factor de carga
+// de 1/2 como máximo; se busca con sondeo lineal y el borrado desplaza hacia
+// atrás en lugar de dejar lápidas.
+//
+// Normalmente los arrays son vectores propios, pero adopt permite usar arrays
+// externos sin copiarlos, como un fichero proyectado con mmap (StoneMemo).
+// Al crecer, la tabla pasa siempre a vectores propios.
+
+// Finalizador de splitmix64: claves vecinas (celdas contiguas, valores
+// consecutivos) acaban en posiciones sin relación.
+inline uint64_t mix64(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+// Hash por defecto para claves enteras de 64 bits.
+struct Mix64Hash {
+    uint64_t operator()(uint64_t key) const { return mix64(key); }
+};
+
+template <typename Key, typename Value, typename Hash = Mix64Hash>
+class FlatTable {
+public:
+    explicit FlatTable(size_t expected = 16) { rehash(capacity_for(expected)); }
+
+    // Los arrays pueden no ser los vectores propios, así que copiar o mover
+    // tiene que volver a apuntarlos.
+    FlatTable(const FlatTable& other) { copy_from(other); }
+    FlatTable(FlatTable&& other) noexcept { move_from(other); }
+    FlatTable& operator=(const FlatTable& other) {
+        if (this != &other) copy_from(other);
+        return *this;
+    }
+    FlatTable& operator=(FlatTable&& other) noexcept {
+        if (this != &other) move_from(other);
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    void reserve(size_t expected) {
+        size_t capacity = capacity_for(expected);
+        if (capacity > capacity_) rehash(capacity);
+    }
+
+    void clear() {
+        std::fill(used_, used_ + capacity_, 0);
+        size_ = 0;
+    }
+
+    // Inserta key con value si no estaba. Devuelve el valor guardado y si se ha creado.
+    std::pair<Value&, bool> insert(const Key& key, Value value = Value()) {
+        if ((size_ + 1) * 2 > capacity_) rehash(std::max<size_t>(16, capacity_ * 2));
+        size_t slot = home(key);
+        while (used_[slot]) {
+            if (keys_[slot] == key) return {values_[slot], false};
+            slot = (slot + 1) & mask_;
+        }
+        used_[slot] = 1;
+        keys_[slot] = key;
+        values_[slot] = std::move(value);
+        size_++;
+        return {values_[slot], true};
+    }
+
+    Value* find(const Key& key) {
+        size_t slot = locate(key);
+        return slot == npos ? nullptr : &values_[slot];
+    }
+    const Value* find(const Key& key) const {
+        size_t slot = locate(key);
+        return slot == npos ? nullptr : &values_[slot];
+    }
+    bool contains(const Key& key) const { return locate(key) != npos; }
+
+    // Borra key. Los elementos siguientes del mismo grupo se desplazan hacia
+    // atrás para que las búsquedas no se corten en el hueco.
+    bool erase(const Key& key) {
+        size_t hole = locate(key);
+        if (hole == npos) return false;
+        used_[hole] = 0;
+        size_--;
+        for (size_t slot = (hole + 1) & mask_; used_[slot]; slot = (slot + 1) & mask_) {
+            size_t ideal = home(keys_[slot]);
+            // Se mueve si su posición ideal no está entre el hueco y su posición actual.
+            if (((slot - ideal) & mask_) >= ((slot - hole) & mask_)) {
+                keys_[hole] = keys_[slot];
+                values_[hole] = std::move(values_[slot]);
+                used_[hole] = 1;
+                used_[slot] = 0;
+                hole = slot;
+            }
+        }
+        return true;
+    }
+
+    // Llama a visit(clave, valor) para cada elemento.
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        for (size_t slot = 0; slot < capacity_; slot++) {
+            if (used_[slot]) visit(keys_[slot], values_[slot]);
+        }
+    }
+
+    // Usa como almacenamiento arrays externos de capacity posiciones, sin
+    // copiarlos. Devuelve false y deja la tabla como estaba si capacity no es
+    // una potencia de dos, o si las posiciones ocupadas no son expected_size o
+    // pasan de la mitad: con la tabla llena, una búsqueda fallida no acabaría.
+    bool adopt(Key* keys, Value* values, uint8_t* used, size_t capacity, size_t expected_size) {
+        if (capacity < 16 || (capacity & (capacity - 1)) != 0 || expected_size * 2 > capacity) return false;
+        size_t occupied = 0;
+        for (size_t slot = 0; slot < capacity; slot++) occupied += used[slot] != 0;
+        if (occupied != expected_size) return false;
+        std::vector<Key>().swap(own_keys_);
+        std::vector<Value>().swap(own_values_);
+        std::vector<uint8_t>().swap(own_used_);
+        keys_ = keys;
+        values_ = values;
+        used_ = used;
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        size_ = occupied;
+        return true;
+    }
+
+    // False mientras la tabla use los arrays de adopt.
+    bool owns_storage() const { return used_ == own_used_.data(); }
+
+    // Arrays de capacity() posiciones, para guardar la tabla tal cual.
+    const Key* keys() const { return keys_; }
+    const Value* values() const { return values_; }
+    const uint8_t* used() const { return used_; }
+
+private:
+    static constexpr size_t npos = SIZE_MAX;
+
+    static size_t capacity_for(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        return capacity;
+    }
+
+    size_t home(const Key& key) const { return static_cast<size_t>(hash_(key)) & mask_; }
+
+    size_t locate(const Key& key) const {
+        if (size_ == 0) return npos;
+        size_t slot = home(key);
+        while (used_[slot]) {
+            if (keys_[slot] == key) return slot;
+            slot = (slot + 1) & mask_;
+        }
+        return npos;
+    }
+
+    // Pasa a vectores propios de la capacidad indicada.
+    void rehash(size_t capacity) {
+        std::vector<Key> old_keys(capacity);
+        std::vector<Value> old_values(capacity);
+        std::vector<uint8_t> old_used(capacity, 0);
+        old_keys.swap(own_keys_);
+        old_values.swap(own_values_);
+        old_used.swap(own_used_);
+        const Key* keys = keys_;
+        Value* values = values_;
+        const uint8_t* used = used_;
+        size_t old_capacity = capacity_;
+        point_to_own();
+        size_ = 0;
+        for (size_t slot = 0; slot < old_capacity; slot++) {
+            if (used[slot]) insert(keys[slot], std::move(values[slot]));
+        }
+    }
+
+    void point_to_own() {
+        keys_ = own_keys_.data();
+        values_ = own_values_.data();
+        used_ = own_used_.data();
+        capacity_ = own_used_.size();
+        mask_ = capacity_ > 0 ? capacity_ - 1 : 0;
+    }
+
+    void copy_from(const FlatTable& other) {
+        own_keys_.assign(other.keys_, other.keys_ + other.capacity_);
+        own_values_.assign(other.values_, other.values_ + other.capacity_);
+        own_used_.assign(other.used_, other.used_ + other.capacity_);
+        point_to_own();
+        size_ = other.size_;
+    }
+
+    // Los vectores movidos conservan su memoria, así que si other los usaba
+    // basta con volver a apuntarlos; si usaba arrays externos, se comparten.
+    void move_from(FlatTable& other) {
+        bool own = other.owns_storage();
+        own_keys_ = std::move(other.own_keys_);
+        own_values_ = std::move(other.own_values_);
+        own_used_ = std::move(other.own_used_);
+        keys_ = other.keys_;
+        values_ = other.values_;
+        used_ = other.used_;
+        capacity_ = other.capacity_;
+        mask_ = other.mask_;
+        size_ = other.size_;
+        if (own) point_to_own();
+        // other queda vacía y sin arrays; la próxima inserción los vuelve a crear.
+        other.own_keys_.clear();
+        other.own_values_.clear();
+        other.own_used_.clear();
+        other.point_to_own();
+        other.size_ = 0;
+    }
+
+    Key* keys_ = nullptr;
+    Value* values_ = nullptr;
+    uint8_t* used_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    std::vector<Key> own_keys_;
+    std::vector<Value> own_values_;
+    std::vector<uint8_t> own_used_;
+    Hash hash_;
+};
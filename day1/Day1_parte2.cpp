@@ -1,93 +1,50 @@
 #include <vector>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
-#include <unordered_map>
-#include <climits>
-typedef struct recurrent{
-    int number_of_times_left_side;
-    int number_of_times_right_side;
-} recurrent;
-void merge(std::vector<int>& array, int ini, int fin){
-    int medio = ini + (fin - ini)/2;
-    int n1 = medio - ini + 1;
-    int n2 = fin - medio;
-    std::vector<int> left(n1),right(n2);
-    for(int i = 0; i< n1; i++){
-        left[i] = array[ini + i];
-    }
-    for(int i = 0; i< n2; i++){
-        right[i] = array[medio +1 + i];
-    }
-    int i = 0, j = 0, k = ini;
-    while (i < n1 && j < n2){
-        if(left[i] <= right[j]){
-            array[k] = left[i];
-            i++;
-        }else{
-            array[k] = right[j];
-            j++;
+#include "day1_input.h"
+#include "day1_stream.h"
+#include "day1_join.h"
+// Modo continuo: lee pares de la entrada estándar y mantiene la similitud al día.
+// Imprime la puntuación cada "every" pares y al terminar.
+int run_stream(size_t every){
+    std::ios::sync_with_stdio(false);
+    StreamingSimilarity similarity;
+    int number1,number2;
+    while(std::cin >> number1 >> number2){
+        similarity.add(number1,number2);
+        if(similarity.pairs() % every == 0){
+            std::cout << similarity.score() << std::endl;
         }
-        k++;
-    }
-    while( i < n1){
-        array[k] = left[i];
-        k++;
-        i++;
     }
-    while( j < n2){
-        array[k] = right[j];
-        k++;
-        j++;
+    if(similarity.pairs() % every != 0){
+        std::cout << similarity.score() << std::endl;
     }
-    
+    return 0;
 }
-void mergesort(std::vector<int>& array,int ini, int fin){
-   if(ini < fin){
-    int medio = ini + (fin - ini)/2;
-    mergesort(array,ini,medio);
-    mergesort(array,medio+1,fin);
-    merge(array,ini,fin);
-   }  
-}
-int main(){
-    std::ifstream file("day1_puzzle.txt");
-    if(!file){
+int main(int argc, char* argv[]){
+    // ./Day1_parte2 --stream [N] < pares
+    if(argc > 1 && std::string(argv[1]) == "--stream"){
+        size_t every = argc > 2 ? std::stoul(argv[2]) : 1;
+        return run_stream(every == 0 ? 1 : every);
+    }
+    // ./Day1_parte2 --join direct|merge|hash fuerza una estrategia concreta
+    JoinStrategy strategy = JoinStrategy::Auto;
+    if(argc > 2 && std::string(argv[1]) == "--join"){
+        strategy = parse_strategy(argv[2]);
+    }
+    Columns columns;
+    if(!load_columns("day1_puzzle.txt",columns)){
         std::cerr << "Error opening the file!"<<std::endl;
         return 1;
     }
-    std::vector<int> left_side = {};
-    std::vector<int> right_side;
-    std::string line;
-   int number1,number2;
-    while(std::getline(file,line)){
-        std::istringstream iss(line);
-        if(iss >> number1 >> number2){
-            left_side.push_back(number1);
-            right_side.push_back(number2);
-        }   
-    }
-    mergesort(left_side,0,left_side.size() - 1);
-    std::unordered_map<int,recurrent> map;
-    int last_number = INT_MIN;
-    for (int number : left_side){
-        if(number == last_number){
-           map[number].number_of_times_left_side +=1;
-        }else{
-            map[number] = {1,0};
-        }
-        last_number = number;
-    }
-    for(int number : right_side){
-        if(map.find(number) == map.end()){
-            continue; // not exist this number in the left side
-        }
-        map[number].number_of_times_right_side += 1;
-    }
-    int similarity = 0;
-    for(const auto& pair : map){
-        similarity += pair.second.number_of_times_left_side * pair.second.number_of_times_right_side * pair.first;
+    std::vector<int>& left_side = columns.left;
+    std::vector<int>& right_side = columns.right;
+    JoinResult join = similarity_join(left_side,right_side,strategy);
+    if(strategy != JoinStrategy::Auto && join.strategy != strategy){
+        std::cerr << "Aviso: " << strategy_name(strategy) << " no es posible con este rango de claves, se usa "
+                  << strategy_name(join.strategy) << std::endl;
     }
+    std::cerr << "join: " << strategy_name(join.strategy) << " (" << join.milliseconds << " ms)" << std::endl;
+    int64_t similarity = join.similarity;
     std::cout <<similarity;
 }
@@ -0,0 +1,193 @@
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include "day1_sort.h"
+#include "day1_input.h"
+#include "day1_reduce.h"
+#include "day1_join.h"
+
+// Benchmarks del día 1. Uso: ./day1_bench [sort|parse|reduce|join] [archivo]
+
+// Mergesort original de Day1_parte1.cpp, conservado como referencia.
+void merge(std::vector<int>& array, int ini, int fin) {
+    int medio = ini + (fin - ini) / 2;
+    int n1 = medio - ini + 1;
+    int n2 = fin - medio;
+    std::vector<int> left(n1), right(n2);
+    for (int i = 0; i < n1; i++) left[i] = array[ini + i];
+    for (int i = 0; i < n2; i++) right[i] = array[medio + 1 + i];
+    int i = 0, j = 0, k = ini;
+    while (i < n1 && j < n2) {
+        if (left[i] <= right[j]) array[k++] = left[i++];
+        else array[k++] = right[j++];
+    }
+    while (i < n1) array[k++] = left[i++];
+    while (j < n2) array[k++] = right[j++];
+}
+
+void mergesort(std::vector<int>& array, int ini, int fin) {
+    if (ini < fin) {
+        int medio = ini + (fin - ini) / 2;
+        mergesort(array, ini, medio);
+        mergesort(array, medio + 1, fin);
+        merge(array, ini, fin);
+    }
+}
+
+// Lista aleatoria de números de 5 cifras, como en la entrada del puzzle.
+std::vector<int> random_column(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(10000, 99999);
+    std::vector<int> column(n);
+    for (auto& v : column) v = dist(rng);
+    return column;
+}
+
+// Ejecuta f y devuelve los milisegundos transcurridos.
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void bench_sort() {
+    std::cout << "== sort (ms por columna) ==\n";
+    std::cout << "n\tmergesort\tradix\tparallel\tsort_columns(x2)\n";
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        std::vector<int> base = random_column(n, 42);
+        std::vector<int> expected = base;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> a = base;
+        double t_merge = time_ms([&]() { mergesort(a, 0, static_cast<int>(a.size()) - 1); });
+        std::vector<int> b = base;
+        double t_radix = time_ms([&]() { radix_sort(b); });
+        std::vector<int> c = base;
+        double t_parallel = time_ms([&]() { parallel_radix_sort(c); });
+        std::vector<int> l = base, r = random_column(n, 7);
+        double t_columns = time_ms([&]() { sort_columns(l, r); });
+
+        if (a != expected || b != expected || c != expected || l != expected) {
+            std::cerr << "Error: resultado incorrecto con n = " << n << std::endl;
+        }
+        std::cout << n << '\t' << t_merge << '\t' << t_radix << '\t' << t_parallel << '\t' << t_columns << '\n';
+    }
+}
+
+// Lectura original: getline más un istringstream por línea.
+bool load_with_streams(const char* path, Columns& cols) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    int number1, number2;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        if (iss >> number1 >> number2) {
+            cols.left.push_back(number1);
+            cols.right.push_back(number2);
+        }
+    }
+    return true;
+}
+
+// Compara el throughput de ambos lectores. Si no se indica archivo se genera
+// uno temporal con el formato del puzzle.
+void bench_parse(const char* path) {
+    std::string generated;
+    if (path == nullptr) {
+        generated = "day1_bench_input.tmp";
+        std::ofstream out(generated);
+        std::vector<int> l = random_column(5000000, 1), r = random_column(5000000, 2);
+        for (size_t i = 0; i < l.size(); i++) out << l[i] << "   " << r[i] << '\n';
+        path = generated.c_str();
+    }
+
+    std::cout << "== parse (MB/s) ==\n";
+    Columns streams, mapped;
+    size_t bytes = 0;
+    double t_streams = time_ms([&]() { load_with_streams(path, streams); });
+    double t_mapped = time_ms([&]() { load_columns(path, mapped, &bytes); });
+    if (streams.left != mapped.left || streams.right != mapped.right) {
+        std::cerr << "Error: los lectores no coinciden" << std::endl;
+    }
+    double mb = bytes / (1024.0 * 1024.0);
+    std::cout << "bytes: " << bytes << ", filas: " << mapped.left.size() << '\n';
+    std::cout << "getline+istringstream\t" << mb / (t_streams / 1000.0) << " MB/s\n";
+    std::cout << "mmap+parse_columns\t" << mb / (t_mapped / 1000.0) << " MB/s\n";
+
+    if (!generated.empty()) std::remove(generated.c_str());
+}
+
+// Impide que el compilador saque del bucle de repeticiones una llamada sin efectos.
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Microbenchmark de las reducciones: millones de elementos por segundo.
+void bench_reduce() {
+    std::cout << "== reduce (Melem/s) ==\n";
+    const size_t n = 10000000;
+    const int reps = 10;
+    std::vector<int> a = random_column(n, 3), b = random_column(n, 4);
+    std::vector<int> left_count = random_column(n, 5), right_count = random_column(n, 6);
+    // Valores negativos para comprobar también el signo.
+    for (size_t i = 0; i < n; i += 3) a[i] = -a[i];
+
+    auto report = [&](const char* name, double ms) {
+        std::cout << name << '\t' << (double(n) * reps / 1e6) / (ms / 1000.0) << '\n';
+    };
+
+    int64_t r_scalar = 0, r_avx2 = 0;
+    report("abs_diff scalar", time_ms([&]() { for (int k = 0; k < reps; k++, clobber_memory()) r_scalar += abs_diff_sum_scalar(a.data(), b.data(), n); }));
+#ifdef DAY1_HAS_AVX2_KERNELS
+    if (cpu_has_avx2()) {
+        report("abs_diff avx2", time_ms([&]() { for (int k = 0; k < reps; k++, clobber_memory()) r_avx2 += abs_diff_sum_avx2(a.data(), b.data(), n); }));
+        if (r_scalar != r_avx2) std::cerr << "Error: abs_diff no coincide" << std::endl;
+    }
+#endif
+
+    r_scalar = r_avx2 = 0;
+    report("weighted scalar", time_ms([&]() { for (int k = 0; k < reps; k++, clobber_memory()) r_scalar += weighted_product_sum_scalar(a.data(), left_count.data(), right_count.data(), n); }));
+#ifdef DAY1_HAS_AVX2_KERNELS
+    if (cpu_has_avx2()) {
+        report("weighted avx2", time_ms([&]() { for (int k = 0; k < reps; k++, clobber_memory()) r_avx2 += weighted_product_sum_avx2(a.data(), left_count.data(), right_count.data(), n); }));
+        if (r_scalar != r_avx2) std::cerr << "Error: weighted no coincide" << std::endl;
+    }
+#endif
+}
+
+// Tiempo de cada estrategia de join y la que elegiría el modo automático.
+void bench_join() {
+    std::cout << "== join (ms) ==\n";
+    std::cout << "n\tdirect\tsort-merge\thash\tauto\n";
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        std::vector<int> left = random_column(n, 8), right = random_column(n, 9);
+        JoinResult direct = similarity_join(left, right, JoinStrategy::Direct);
+        JoinResult merge = similarity_join(left, right, JoinStrategy::SortMerge);
+        JoinResult hash = similarity_join(left, right, JoinStrategy::Hash);
+        JoinResult chosen = similarity_join(left, right);
+        if (direct.similarity != merge.similarity || merge.similarity != hash.similarity) {
+            std::cerr << "Error: las estrategias no coinciden con n = " << n << std::endl;
+        }
+        std::cout << n << '\t' << direct.milliseconds << '\t' << merge.milliseconds << '\t' << hash.milliseconds
+                  << '\t' << strategy_name(chosen.strategy) << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string which = argc > 1 ? argv[1] : "all";
+    const char* path = argc > 2 ? argv[2] : nullptr;
+    if (which == "all" || which == "sort") bench_sort();
+    if (which == "all" || which == "parse") bench_parse(path);
+    if (which == "all" || which == "reduce") bench_reduce();
+    if (which == "all" || which == "join") bench_join();
+    return 0;
+}
@@ -0,0 +1,285 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unistd.h>
+#include "day1_sort.h"
+#include "day1_input.h"
+
+// Modo de memoria externa para la distancia total del día 1.
+// Las columnas se ordenan por tramos que caben en el presupuesto de memoria,
+// cada tramo se vuelca a un archivo temporal y al final se mezclan los k
+// tramos de cada columna a la vez, sumando la distancia durante la mezcla.
+// Si hay demasiados tramos para darle a cada uno un buffer de lectura útil,
+// antes se mezclan por grupos en tramos más largos.
+//
+// Memoria de cada fase, con B = presupuesto:
+//  - fase 1: dos columnas del tramo (B/2) + auxiliar del radix sort (B/4) +
+//    bloque de lectura (B/32) + línea pendiente (B/16, salvo líneas más largas) +
+//    números decodificados del bloque (como mucho 2 enteros por cada 4 bytes, B/8);
+//  - mezclas: lectores (buffer + lector + entrada del heap por tramo) y, en
+//    las pasadas intermedias, un buffer de salida, todo dentro de B.
+// Fuera de la cuenta quedan el índice de tramos de cada RunFile (16 bytes por
+// tramo) y los buffers de stdio de los temporales. Con presupuestos por
+// debajo de unos 64 KB mandan los mínimos de cada buffer y se pasa de B.
+
+// Tramos ordenados de una columna, guardados uno detrás de otro en un archivo temporal.
+class RunFile {
+public:
+    RunFile() : file_(std::tmpfile()) {}
+    ~RunFile() {
+        if (file_) std::fclose(file_);
+    }
+    RunFile(const RunFile&) = delete;
+    RunFile& operator=(const RunFile&) = delete;
+
+    bool ok() const { return file_ != nullptr; }
+
+    // Añade un tramo ya ordenado al final del archivo.
+    bool append_run(const std::vector<int>& run) {
+        if (run.empty()) return true;
+        begin_run();
+        return write_values(run.data(), run.size());
+    }
+
+    // Empieza un tramo nuevo que se escribe por partes con write_values.
+    void begin_run() {
+        run_offsets_.push_back(written_);
+        run_lengths_.push_back(0);
+    }
+
+    // Añade valores al último tramo empezado.
+    bool write_values(const int* values, size_t count) {
+        size_t bytes = count * sizeof(int);
+        if (std::fwrite(values, 1, bytes, file_) != bytes) return false;
+        written_ += bytes;
+        run_lengths_.back() += count;
+        return true;
+    }
+
+    bool flush() { return std::fflush(file_) == 0; }
+    int fd() const { return fileno(file_); }
+    size_t runs() const { return run_lengths_.size(); }
+    size_t run_offset(size_t r) const { return run_offsets_[r]; }
+    size_t run_length(size_t r) const { return run_lengths_[r]; }
+
+private:
+    std::FILE* file_;
+    size_t written_ = 0;
+    std::vector<size_t> run_offsets_;
+    std::vector<size_t> run_lengths_;
+};
+
+// Mezcla k-vías de count tramos de un RunFile a partir de first (por defecto
+// todos). Cada tramo se lee con pread a través de un buffer propio, así que la
+// memoria usada es k * (buffer + RUN_OVERHEAD).
+class RunMerger {
+public:
+    // Enteros por buffer como mínimo: con menos, el coste lo ponen los pread.
+    static constexpr size_t MIN_BUFFER_INTS = 256;
+
+    RunMerger(const RunFile& runs, size_t buffer_ints, size_t first = 0, size_t count = SIZE_MAX)
+        : runs_(runs), readers_(std::min(count, runs.runs() - first)) {
+        for (size_t r = 0; r < readers_.size(); r++) {
+            Reader& reader = readers_[r];
+            reader.offset = runs.run_offset(first + r);
+            reader.remaining = runs.run_length(first + r);
+            reader.buffer.resize(std::min(buffer_ints, reader.remaining));
+            if (refill(reader)) heap_.push({reader.buffer[0], r});
+        }
+    }
+
+    // Devuelve el siguiente valor en orden global; false cuando se agotan los tramos.
+    bool next(int& value) {
+        if (heap_.empty()) return false;
+        auto [top, r] = heap_.top();
+        heap_.pop();
+        value = top;
+        Reader& reader = readers_[r];
+        reader.pos++;
+        if (reader.pos < reader.size || refill(reader)) {
+            heap_.push({reader.buffer[reader.pos], r});
+        }
+        return true;
+    }
+
+    bool failed() const { return failed_; }
+
+private:
+    struct Reader {
+        std::vector<int> buffer;
+        size_t pos = 0;
+        size_t size = 0;
+        size_t offset = 0;     // Siguiente byte a leer del archivo
+        size_t remaining = 0;  // Enteros del tramo aún sin leer
+    };
+    using Entry = std::pair<int, size_t>;
+
+public:
+    // Bytes por tramo además de su buffer.
+    static constexpr size_t RUN_OVERHEAD = sizeof(Reader) + sizeof(Entry);
+
+    // Enteros por buffer para mezclar runs tramos con memory bytes, sin bajar del mínimo.
+    static size_t buffer_for(size_t memory, size_t runs) {
+        size_t per_run = memory / std::max<size_t>(1, runs);
+        size_t ints = per_run > RUN_OVERHEAD ? (per_run - RUN_OVERHEAD) / sizeof(int) : 0;
+        return std::max(MIN_BUFFER_INTS, ints);
+    }
+
+    // Tramos que se pueden mezclar con memory bytes dándole a cada uno el buffer mínimo.
+    static size_t max_runs(size_t memory) {
+        return std::max<size_t>(2, memory / (MIN_BUFFER_INTS * sizeof(int) + RUN_OVERHEAD));
+    }
+
+private:
+    bool refill(Reader& reader) {
+        if (reader.remaining == 0) return false;
+        size_t count = std::min(reader.buffer.size(), reader.remaining);
+        size_t bytes = count * sizeof(int);
+        ssize_t got = pread(runs_.fd(), reader.buffer.data(), bytes, static_cast<off_t>(reader.offset));
+        if (got != static_cast<ssize_t>(bytes)) {
+            failed_ = true;
+            reader.remaining = 0;
+            return false;
+        }
+        reader.offset += bytes;
+        reader.remaining -= count;
+        reader.pos = 0;
+        reader.size = count;
+        return true;
+    }
+
+    const RunFile& runs_;
+    std::vector<Reader> readers_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+    bool failed_ = false;
+};
+
+// Pasada intermedia: mezcla los tramos de in en grupos de fan_in y deja en out
+// un tramo por grupo. Usa (fan_in + 1) buffers de buffer_ints enteros.
+inline bool merge_run_groups(const RunFile& in, size_t fan_in, size_t buffer_ints, RunFile& out) {
+    std::vector<int> output;
+    output.reserve(buffer_ints);
+    for (size_t first = 0; first < in.runs(); first += fan_in) {
+        RunMerger merger(in, buffer_ints, first, fan_in);
+        out.begin_run();
+        int value;
+        while (merger.next(value)) {
+            output.push_back(value);
+            if (output.size() == buffer_ints) {
+                if (!out.write_values(output.data(), output.size())) return false;
+                output.clear();
+            }
+        }
+        if (!out.write_values(output.data(), output.size()) || merger.failed()) return false;
+        output.clear();
+    }
+    return out.flush();
+}
+
+// Reduce los tramos de una columna con pasadas intermedias hasta que no haya
+// más de target. runs se sustituye por el archivo de la última pasada.
+inline bool reduce_runs(std::unique_ptr<RunFile>& runs, size_t target, size_t memory_budget) {
+    size_t fan_in = std::max<size_t>(2, RunMerger::max_runs(memory_budget) - 1);
+    size_t buffer_ints = RunMerger::buffer_for(memory_budget, fan_in + 1);
+    while (runs->runs() > target) {
+        auto merged = std::make_unique<RunFile>();
+        if (!merged->ok() || !merge_run_groups(*runs, fan_in, buffer_ints, *merged)) return false;
+        runs = std::move(merged);
+    }
+    return true;
+}
+
+// Calcula la distancia total sin tener nunca una columna entera en memoria.
+// memory_budget es el número aproximado de bytes que se permite usar.
+// Devuelve false si no se puede leer la entrada o escribir los temporales.
+inline bool external_total_distance(const char* path, size_t memory_budget, int64_t& distance) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    // Fase 1: tramos ordenados. Se usan 3/4 del presupuesto para las dos
+    // columnas más el buffer auxiliar del radix sort, y el resto para leer la
+    // entrada (ver el reparto al principio del archivo).
+    size_t run_length = std::max<size_t>(1024, memory_budget / (4 * sizeof(int)));
+    size_t block_size = std::max<size_t>(4096, memory_budget / 32);
+
+    auto left_runs = std::make_unique<RunFile>();
+    auto right_runs = std::make_unique<RunFile>();
+    if (!left_runs->ok() || !right_runs->ok()) return false;
+
+    Columns run;
+    run.left.reserve(run_length);
+    run.right.reserve(run_length);
+    std::string block(block_size, '\0');
+    std::string carry; // Línea incompleta al final del bloque anterior
+    carry.reserve(2 * block_size);
+
+    auto spill = [&]() {
+        radix_sort(run.left);
+        radix_sort(run.right);
+        bool ok = left_runs->append_run(run.left) && right_runs->append_run(run.right);
+        run.left.clear();
+        run.right.clear();
+        return ok;
+    };
+
+    Columns parsed;
+    while (file) {
+        file.read(&block[0], block_size);
+        size_t got = static_cast<size_t>(file.gcount());
+        if (got == 0) break;
+        carry.append(block, 0, got);
+        // Solo se procesan líneas completas, salvo al llegar al final del archivo.
+        size_t cut = file ? carry.rfind('\n') : carry.size() - 1;
+        if (cut == std::string::npos) continue;
+        parse_columns(carry.data(), cut + 1, parsed);
+        carry.erase(0, cut + 1);
+
+        for (size_t i = 0; i < parsed.left.size(); i++) {
+            run.left.push_back(parsed.left[i]);
+            run.right.push_back(parsed.right[i]);
+            if (run.left.size() == run_length && !spill()) return false;
+        }
+    }
+    if (!carry.empty()) {
+        parse_columns(carry.data(), carry.size(), parsed);
+        for (size_t i = 0; i < parsed.left.size(); i++) {
+            run.left.push_back(parsed.left[i]);
+            run.right.push_back(parsed.right[i]);
+        }
+    }
+    if (!run.left.empty() && !spill()) return false;
+    if (!left_runs->flush() || !right_runs->flush()) return false;
+
+    // Liberar la memoria de la fase 1 antes de la mezcla.
+    std::vector<int>().swap(run.left);
+    std::vector<int>().swap(run.right);
+    std::vector<int>().swap(parsed.left);
+    std::vector<int>().swap(parsed.right);
+    std::string().swap(block);
+    std::string().swap(carry);
+
+    // Fase 2: mezcla simultánea de ambas columnas, con la mitad del
+    // presupuesto para cada una. Si no caben todos los tramos con el buffer
+    // mínimo, antes se reducen con pasadas intermedias.
+    size_t target = RunMerger::max_runs(memory_budget / 2);
+    if (!reduce_runs(left_runs, target, memory_budget) || !reduce_runs(right_runs, target, memory_budget)) return false;
+    size_t buffer_ints = RunMerger::buffer_for(memory_budget / 2, left_runs->runs());
+    RunMerger left_merge(*left_runs, buffer_ints);
+    RunMerger right_merge(*right_runs, buffer_ints);
+
+    distance = 0;
+    int l, r;
+    while (left_merge.next(l) && right_merge.next(r)) {
+        distance += std::llabs(static_cast<long long>(l) - r);
+    }
+    return !left_merge.failed() && !right_merge.failed();
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Lector de la entrada de dos columnas del día 1.
+// El archivo se proyecta en memoria con mmap y se recorre directamente,
+// sin crear un std::string ni un std::istringstream por línea.
+
+// Las dos listas en formato "structure of arrays".
+struct Columns {
+    std::vector<int> left;
+    std::vector<int> right;
+};
+
+// Archivo proyectado en memoria de solo lectura.
+class MappedFile {
+public:
+    explicit MappedFile(const char* path) {
+        fd_ = open(path, O_RDONLY);
+        if (fd_ < 0) return;
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return;
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ok_ = true;
+            return;
+        }
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) return;
+        madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+        ok_ = true;
+    }
+    ~MappedFile() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) close(fd_);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return ok_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    int fd_ = -1;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool ok_ = false;
+};
+
+inline bool is_digit(char c) {
+    return static_cast<unsigned char>(c - '0') <= 9;
+}
+
+// Espacios que salta operator>> dentro de una línea.
+inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Número de saltos de línea, para reservar las columnas de una sola vez.
+inline size_t count_lines(const char* p, size_t n) {
+    size_t lines = 0, i = 0;
+#ifdef __SSE2__
+    __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        lines += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+    }
+#endif
+    for (; i < n; i++) lines += p[i] == '\n';
+    return lines;
+}
+
+// Decodifica los pares "izquierda derecha" de un buffer con las mismas reglas
+// que el bucle original con istringstream (iss >> izquierda >> derecha): cada
+// número son espacios opcionales, un signo opcional y al menos una cifra, y
+// tiene que caber en un int. Las líneas donde falla cualquiera de los dos
+// números se descartan; lo que haya detrás del segundo se ignora.
+inline void parse_columns(const char* p, size_t n, Columns& cols) {
+    size_t capacity = count_lines(p, n) + 1;
+    cols.left.resize(capacity);
+    cols.right.resize(capacity);
+    int* left = cols.left.data();
+    int* right = cols.right.data();
+    size_t rows = 0;
+
+    // Lee un número desde i sin pasar de line_end. Devuelve false si lo que
+    // hay no es un número o no cabe en un int.
+    auto read_number = [&](size_t& i, size_t line_end, int& value) {
+        while (i < line_end && is_blank(p[i])) i++;
+        bool negative = i < line_end && p[i] == '-';
+        if (i < line_end && (p[i] == '-' || p[i] == '+')) i++;
+        if (i == line_end || !is_digit(p[i])) return false;
+        // INT_MIN tiene una unidad más de magnitud que INT_MAX.
+        int64_t limit = negative ? -static_cast<int64_t>(INT_MIN) : INT_MAX;
+        int64_t magnitude = 0;
+        for (; i < line_end && is_digit(p[i]); i++) {
+            magnitude = magnitude * 10 + (p[i] - '0');
+            if (magnitude > limit) return false;
+        }
+        value = static_cast<int>(negative ? -magnitude : magnitude);
+        return true;
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        const char* newline = static_cast<const char*>(memchr(p + i, '\n', n - i));
+        size_t line_end = newline ? static_cast<size_t>(newline - p) : n;
+        int first, second;
+        if (read_number(i, line_end, first) && read_number(i, line_end, second)) {
+            left[rows] = first;
+            right[rows] = second;
+            rows++;
+        }
+        i = line_end + 1;
+    }
+
+    cols.left.resize(rows);
+    cols.right.resize(rows);
+}
+
+// Carga las dos columnas desde un archivo. Devuelve false si no se puede abrir.
+inline bool load_columns(const char* path, Columns& cols, size_t* bytes_read = nullptr) {
+    MappedFile file(path);
+    if (!file.ok()) return false;
+    parse_columns(file.data(), file.size(), cols);
+    if (bytes_read) *bytes_read = file.size();
+    return true;
+}
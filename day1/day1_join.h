@@ -0,0 +1,186 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <chrono>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include "day1_sort.h"
+#include "day1_reduce.h"
+
+// Motor de "join" para la similitud del día 1: cruza los valores de la lista
+// izquierda con los de la derecha y suma valor * veces_izquierda * veces_derecha.
+// Tiene tres estrategias y elige una según el rango de claves y el tamaño.
+
+enum class JoinStrategy { Auto, Direct, SortMerge, Hash };
+
+inline const char* strategy_name(JoinStrategy strategy) {
+    switch (strategy) {
+        case JoinStrategy::Direct: return "direct";
+        case JoinStrategy::SortMerge: return "sort-merge";
+        case JoinStrategy::Hash: return "hash";
+        default: return "auto";
+    }
+}
+
+inline JoinStrategy parse_strategy(const std::string& name) {
+    if (name == "direct") return JoinStrategy::Direct;
+    if (name == "merge" || name == "sort-merge") return JoinStrategy::SortMerge;
+    if (name == "hash") return JoinStrategy::Hash;
+    return JoinStrategy::Auto;
+}
+
+typedef struct recurrent{
+    int number_of_times_left_side;
+    int number_of_times_right_side;
+} recurrent;
+
+// Estadísticas de las claves que se usan para decidir la estrategia.
+struct JoinStats {
+    size_t left_size = 0;
+    size_t right_size = 0;
+    int min_key = INT_MAX;
+    int max_key = INT_MIN;
+    bool left_sorted = false;
+
+    // Número de casillas que necesitaría una tabla indexada directamente.
+    uint64_t key_span() const {
+        return min_key > max_key ? 0 : static_cast<uint64_t>(static_cast<int64_t>(max_key) - min_key) + 1;
+    }
+};
+
+struct JoinResult {
+    JoinStrategy strategy;
+    int64_t similarity;
+    double milliseconds;
+};
+
+inline JoinStats join_stats(const std::vector<int>& left_side, const std::vector<int>& right_side) {
+    JoinStats stats;
+    stats.left_size = left_side.size();
+    stats.right_size = right_side.size();
+    for (int v : left_side) {
+        stats.min_key = std::min(stats.min_key, v);
+        stats.max_key = std::max(stats.max_key, v);
+    }
+    for (int v : right_side) {
+        stats.min_key = std::min(stats.min_key, v);
+        stats.max_key = std::max(stats.max_key, v);
+    }
+    stats.left_sorted = std::is_sorted(left_side.begin(), left_side.end());
+    return stats;
+}
+
+// Rango de claves máximo de la tabla directa: tres arrays de 4 bytes por
+// casilla, unos 768 MiB en el límite. Vale también cuando se fuerza Direct.
+constexpr uint64_t DIRECT_JOIN_MAX_SPAN = uint64_t(1) << 26;
+
+// Tabla directa si el rango de claves es pequeño comparado con la entrada
+// (los números del puzzle tienen 5 cifras); si no, sort-merge para listas
+// grandes, donde el radix sort es lineal; y hash para el resto.
+inline JoinStrategy choose_strategy(const JoinStats& stats) {
+    uint64_t rows = stats.left_size + stats.right_size;
+    uint64_t span = stats.key_span();
+    if (span <= DIRECT_JOIN_MAX_SPAN && span <= 16 * rows) {
+        return JoinStrategy::Direct;
+    }
+    if (stats.left_sorted || rows >= (uint64_t(1) << 16)) {
+        return JoinStrategy::SortMerge;
+    }
+    return JoinStrategy::Hash;
+}
+
+// Contadores indexados por (clave - min_key); sin hashing ni ordenación.
+inline int64_t direct_join(const std::vector<int>& left_side, const std::vector<int>& right_side, const JoinStats& stats) {
+    size_t span = static_cast<size_t>(stats.key_span());
+    if (span == 0) return 0;
+    std::vector<int> left_times(span, 0), right_times(span, 0);
+    for (int v : left_side) left_times[static_cast<size_t>(static_cast<int64_t>(v) - stats.min_key)]++;
+    for (int v : right_side) right_times[static_cast<size_t>(static_cast<int64_t>(v) - stats.min_key)]++;
+
+    // Los valores de la tabla son consecutivos a partir de min_key.
+    std::vector<int> values(span);
+    for (size_t i = 0; i < span; i++) values[i] = static_cast<int>(stats.min_key + static_cast<int64_t>(i));
+    return weighted_product_sum(values.data(), left_times.data(), right_times.data(), span);
+}
+
+// Ordena ambas listas y recorre las dos a la vez agrupando valores iguales.
+inline int64_t sort_merge_join(std::vector<int> left_side, std::vector<int> right_side, bool left_sorted) {
+    if (left_sorted) parallel_radix_sort(right_side);
+    else sort_columns(left_side, right_side);
+
+    int64_t similarity = 0;
+    size_t i = 0, j = 0;
+    while (i < left_side.size() && j < right_side.size()) {
+        if (left_side[i] < right_side[j]) {
+            i++;
+        } else if (right_side[j] < left_side[i]) {
+            j++;
+        } else {
+            int value = left_side[i];
+            int64_t left_times = 0, right_times = 0;
+            while (i < left_side.size() && left_side[i] == value) { left_times++; i++; }
+            while (j < right_side.size() && right_side[j] == value) { right_times++; j++; }
+            similarity += value * left_times * right_times;
+        }
+    }
+    return similarity;
+}
+
+// La versión original: mapa con los contadores de cada valor de la izquierda.
+inline int64_t hash_join(const std::vector<int>& left_side, const std::vector<int>& right_side) {
+    std::unordered_map<int,recurrent> map;
+    map.reserve(left_side.size());
+    for (int number : left_side) {
+        auto it = map.find(number);
+        if (it == map.end()) map[number] = {1,0};
+        else it->second.number_of_times_left_side += 1;
+    }
+    for (int number : right_side) {
+        auto it = map.find(number);
+        if (it == map.end()) continue; // not exist this number in the left side
+        it->second.number_of_times_right_side += 1;
+    }
+    std::vector<int> values, left_times, right_times;
+    values.reserve(map.size());
+    left_times.reserve(map.size());
+    right_times.reserve(map.size());
+    for (const auto& pair : map) {
+        values.push_back(pair.first);
+        left_times.push_back(pair.second.number_of_times_left_side);
+        right_times.push_back(pair.second.number_of_times_right_side);
+    }
+    return weighted_product_sum(values.data(), left_times.data(), right_times.data(), values.size());
+}
+
+// Calcula la similitud con la estrategia pedida (o la elegida automáticamente).
+// Si se pide Direct con un rango de claves mayor que DIRECT_JOIN_MAX_SPAN se
+// usa hash; result.strategy dice siempre la estrategia que se ha usado.
+inline JoinResult similarity_join(const std::vector<int>& left_side, const std::vector<int>& right_side, JoinStrategy strategy = JoinStrategy::Auto) {
+    auto start = std::chrono::steady_clock::now();
+    JoinStats stats = join_stats(left_side, right_side);
+    if (strategy == JoinStrategy::Auto) strategy = choose_strategy(stats);
+
+    JoinResult result{strategy, 0, 0.0};
+    switch (strategy) {
+        case JoinStrategy::Direct:
+            if (stats.key_span() > DIRECT_JOIN_MAX_SPAN) {
+                result.strategy = JoinStrategy::Hash;
+                result.similarity = hash_join(left_side, right_side);
+            } else {
+                result.similarity = direct_join(left_side, right_side, stats);
+            }
+            break;
+        case JoinStrategy::SortMerge:
+            result.similarity = sort_merge_join(left_side, right_side, stats.left_sorted);
+            break;
+        default:
+            result.similarity = hash_join(left_side, right_side);
+            break;
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DAY1_HAS_AVX2_KERNELS 1
+#endif
+
+// Reducciones del día 1 acumuladas en 64 bits para que no se desborden con
+// listas grandes. Hay una versión escalar y otra AVX2; la función sin sufijo
+// elige la mejor en tiempo de ejecución.
+
+// Suma de |a[i] - b[i]|.
+inline int64_t abs_diff_sum_scalar(const int* a, const int* b, size_t n) {
+    int64_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        int64_t d = static_cast<int64_t>(a[i]) - b[i];
+        total += d < 0 ? -d : d;
+    }
+    return total;
+}
+
+// Suma de values[i] * left_count[i] * right_count[i]. Los contadores no pueden ser negativos.
+inline int64_t weighted_product_sum_scalar(const int* values, const int* left_count, const int* right_count, size_t n) {
+    int64_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += static_cast<int64_t>(values[i]) * left_count[i] * right_count[i];
+    }
+    return total;
+}
+
+#ifdef DAY1_HAS_AVX2_KERNELS
+// Suma horizontal de los cuatro carriles de 64 bits.
+__attribute__((target("avx2"))) inline int64_t horizontal_sum_epi64(__m256i v) {
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+__attribute__((target("avx2"))) inline int64_t abs_diff_sum_avx2(const int* a, const int* b, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // Se amplía a 64 bits antes de restar para que la diferencia no se desborde.
+        __m256i a_lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(va));
+        __m256i a_hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(va, 1));
+        __m256i b_lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vb));
+        __m256i b_hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vb, 1));
+        __m256i d_lo = _mm256_sub_epi64(a_lo, b_lo);
+        __m256i d_hi = _mm256_sub_epi64(a_hi, b_hi);
+        // AVX2 no tiene abs de 64 bits: |d| = (d ^ signo) - signo.
+        __m256i s_lo = _mm256_cmpgt_epi64(_mm256_setzero_si256(), d_lo);
+        __m256i s_hi = _mm256_cmpgt_epi64(_mm256_setzero_si256(), d_hi);
+        acc0 = _mm256_add_epi64(acc0, _mm256_sub_epi64(_mm256_xor_si256(d_lo, s_lo), s_lo));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sub_epi64(_mm256_xor_si256(d_hi, s_hi), s_hi));
+    }
+    return horizontal_sum_epi64(_mm256_add_epi64(acc0, acc1)) + abs_diff_sum_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline int64_t weighted_product_sum_avx2(const int* values, const int* left_count, const int* right_count, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        __m256i l = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left_count + i)));
+        __m256i r = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(right_count + i)));
+        // v * l con signo en 64 bits.
+        __m256i vl = _mm256_mul_epi32(v, l);
+        // (v * l) * r módulo 2^64 con r no negativo: parte baja * r + (parte alta * r) << 32.
+        __m256i lo = _mm256_mul_epu32(vl, r);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(vl, 32), r);
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+    }
+    return horizontal_sum_epi64(acc) + weighted_product_sum_scalar(values + i, left_count + i, right_count + i, n - i);
+}
+#endif
+
+inline bool cpu_has_avx2() {
+#ifdef DAY1_HAS_AVX2_KERNELS
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+inline int64_t abs_diff_sum(const int* a, const int* b, size_t n) {
+#ifdef DAY1_HAS_AVX2_KERNELS
+    if (cpu_has_avx2()) return abs_diff_sum_avx2(a, b, n);
+#endif
+    return abs_diff_sum_scalar(a, b, n);
+}
+
+inline int64_t weighted_product_sum(const int* values, const int* left_count, const int* right_count, size_t n) {
+#ifdef DAY1_HAS_AVX2_KERNELS
+    if (cpu_has_avx2()) return weighted_product_sum_avx2(values, left_count, right_count, n);
+#endif
+    return weighted_product_sum_scalar(values, left_count, right_count, n);
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+// Ordenación radix LSD para claves de 32 bits.
+// Se hacen 4 pasadas de 8 bits usando un único buffer auxiliar, sin
+// reservar memoria en cada nivel como hacía el mergesort recursivo.
+
+// Convierte un int con signo en una clave sin signo que conserva el orden.
+inline uint32_t radix_key(int value) {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+// Versión secuencial: un histograma por pasada y reparto sobre el buffer auxiliar.
+inline void radix_sort(std::vector<int>& array) {
+    size_t n = array.size();
+    if (n < 2) return;
+
+    std::vector<int> scratch(n);
+    int* src = array.data();
+    int* dst = scratch.data();
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t count[256] = {0};
+        for (size_t i = 0; i < n; i++) {
+            count[(radix_key(src[i]) >> shift) & 0xFF]++;
+        }
+
+        // Si todas las claves comparten este byte la pasada no cambia nada.
+        if (count[(radix_key(src[0]) >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[count[(radix_key(src[i]) >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    // Si el resultado quedó en el buffer auxiliar lo copiamos de vuelta.
+    if (src != array.data()) {
+        std::copy(src, src + n, array.data());
+    }
+}
+
+// Versión multihilo: cada hilo calcula el histograma de su trozo y después
+// reparte sus elementos en las posiciones que le corresponden dentro de cada cubo.
+inline void parallel_radix_sort(std::vector<int>& array, unsigned num_threads = std::thread::hardware_concurrency()) {
+    size_t n = array.size();
+    if (num_threads == 0) num_threads = 1;
+    // Con pocos elementos no compensa lanzar hilos.
+    if (num_threads == 1 || n < (size_t(1) << 16)) {
+        radix_sort(array);
+        return;
+    }
+
+    std::vector<int> scratch(n);
+    int* src = array.data();
+    int* dst = scratch.data();
+    size_t chunk = (n + num_threads - 1) / num_threads;
+    std::vector<std::vector<size_t>> count(num_threads, std::vector<size_t>(256));
+    std::vector<std::thread> workers;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        // Histograma por hilo.
+        for (unsigned t = 0; t < num_threads; t++) {
+            workers.emplace_back([&, t]() {
+                std::fill(count[t].begin(), count[t].end(), 0);
+                size_t ini = std::min(n, t * chunk);
+                size_t fin = std::min(n, ini + chunk);
+                for (size_t i = ini; i < fin; i++) {
+                    count[t][(radix_key(src[i]) >> shift) & 0xFF]++;
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        workers.clear();
+
+        // Posiciones de salida: cubo por cubo y, dentro de cada cubo, hilo por hilo.
+        size_t offset = 0;
+        bool trivial = false;
+        for (int b = 0; b < 256; b++) {
+            size_t bucket_total = 0;
+            for (unsigned t = 0; t < num_threads; t++) {
+                size_t c = count[t][b];
+                count[t][b] = offset;
+                offset += c;
+                bucket_total += c;
+            }
+            if (bucket_total == n) trivial = true;
+        }
+        if (trivial) continue;
+
+        // Reparto en paralelo; cada hilo escribe en rangos disjuntos.
+        for (unsigned t = 0; t < num_threads; t++) {
+            workers.emplace_back([&, t]() {
+                size_t ini = std::min(n, t * chunk);
+                size_t fin = std::min(n, ini + chunk);
+                std::vector<size_t>& pos = count[t];
+                for (size_t i = ini; i < fin; i++) {
+                    dst[pos[(radix_key(src[i]) >> shift) & 0xFF]++] = src[i];
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        workers.clear();
+        std::swap(src, dst);
+    }
+
+    if (src != array.data()) {
+        std::copy(src, src + n, array.data());
+    }
+}
+
+// Ordena las dos columnas a la vez, cada una en su propio hilo.
+inline void sort_columns(std::vector<int>& left_side, std::vector<int>& right_side, unsigned num_threads = std::thread::hardware_concurrency()) {
+    unsigned per_column = std::max(1u, num_threads / 2);
+    std::thread left_worker([&]() { parallel_radix_sort(left_side, per_column); });
+    parallel_radix_sort(right_side, per_column);
+    left_worker.join();
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+// Cálculo incremental de la similitud del día 1.
+// similitud = suma de v * veces_izquierda(v) * veces_derecha(v)
+// Al llegar un par (l, r) solo cambian los términos de l y r, así que cada
+// actualización es O(1) y la puntuación está disponible en todo momento.
+class StreamingSimilarity {
+public:
+    // Los valores por debajo de este límite van a la tabla directa; los demás
+    // al mapa, para que un solo valor enorme no reserve gigas de contadores.
+    static constexpr size_t DIRECT_LIMIT = size_t(1) << 20;
+
+    explicit StreamingSimilarity(size_t expected_max_value = 100000)
+        : left_count(std::min(expected_max_value, DIRECT_LIMIT), 0),
+          right_count(std::min(expected_max_value, DIRECT_LIMIT), 0) {}
+
+    // Añade un par (izquierda, derecha) y actualiza la puntuación.
+    void add(int left, int right) {
+        grow(std::max(left, right));
+        // El nuevo valor izquierdo se empareja con todas las apariciones derechas ya vistas.
+        score_ += static_cast<int64_t>(left) * slot(right_count, right_overflow, left);
+        slot(left_count, left_overflow, left)++;
+        // Y el nuevo valor derecho con todas las izquierdas (incluida la que acabamos de sumar).
+        score_ += static_cast<int64_t>(right) * slot(left_count, left_overflow, right);
+        slot(right_count, right_overflow, right)++;
+        pairs_++;
+    }
+
+    int64_t score() const { return score_; }
+    size_t pairs() const { return pairs_; }
+
+private:
+    // Crecer al doble mantiene el coste amortizado constante. Un valor por
+    // debajo de DIRECT_LIMIT siempre cabe en la tabla después de crecer.
+    void grow(int value) {
+        if (value < 0 || static_cast<size_t>(value) < left_count.size()) return;
+        if (left_count.size() >= DIRECT_LIMIT) return;
+        size_t size = std::max(static_cast<size_t>(value) + 1, left_count.size() * 2);
+        size = std::min(size, DIRECT_LIMIT);
+        left_count.resize(size, 0);
+        right_count.resize(size, 0);
+    }
+
+    // Contador de un valor: tabla directa para los no negativos menores que
+    // DIRECT_LIMIT y mapa para el resto.
+    static uint32_t& slot(std::vector<uint32_t>& table, std::unordered_map<int, uint32_t>& overflow, int value) {
+        if (value < 0 || static_cast<size_t>(value) >= table.size()) return overflow[value];
+        return table[static_cast<size_t>(value)];
+    }
+
+    std::vector<uint32_t> left_count;
+    std::vector<uint32_t> right_count;
+    std::unordered_map<int, uint32_t> left_overflow;
+    std::unordered_map<int, uint32_t> right_overflow;
+    int64_t score_ = 0;
+    size_t pairs_ = 0;
+};
@@ -0,0 +1,368 @@
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include "day10_graph.h"
+#include "day10_levels.h"
+#include "day10_parallel.h"
+#include "day10_stencil.h"
+#include "../common/flat_coord_map.h"
+#include <thread>
+
+// Benchmarks del día 10. Uso: ./day10_bench [graph|ratings|scores|threads|stencil|coords] [max_hilos]
+
+// Contador de memoria reservada con new, para comparar el consumo por celda.
+// Es atómico porque también reservan los hilos de bench_threads.
+static std::atomic<size_t> allocated_bytes{0};
+
+void* operator new(std::size_t size) {
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Grafo original de day10_parte1.cpp, conservado como referencia.
+struct Node {
+    int x, y;
+    Node(int x, int y) : x(x), y(y) {}
+    bool operator==(const Node& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct NodeHash {
+    std::size_t operator()(const Node& node) const {
+        return std::hash<int>()(node.x) ^ (std::hash<int>()(node.y) << 1);
+    }
+};
+
+std::unordered_map<Node, std::vector<Node>, NodeHash> build_hashed_graph(const std::vector<std::string>& map) {
+    std::unordered_map<Node, std::vector<Node>, NodeHash> graph;
+    int rows = map.size();
+    int cols = map[0].size();
+    std::vector<std::pair<int, int>> directions = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            Node current(i, j);
+            for (const auto& dir : directions) {
+                int ni = i + dir.first;
+                int nj = j + dir.second;
+                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols) {
+                    if (map[ni][nj] == map[i][j] + 1) {
+                        graph[current].emplace_back(ni, nj);
+                    }
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+// Mapa aleatorio con pendientes suaves para que haya muchos senderos.
+std::vector<std::string> random_map(int rows, int cols, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(0, 2);
+    std::vector<std::string> map(rows, std::string(cols, '0'));
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            map[i][j] = '0' + (i / 3 + j / 2 + noise(rng)) % 10;
+        }
+    }
+    return map;
+}
+
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Tiempo de construcción y bytes por celda de ambos grafos.
+void bench_graph() {
+    std::cout << "== graph ==\n";
+    std::cout << "cells\thash ms\thash B/cell\tcsr ms\tcsr B/cell\n";
+    for (int size = 64; size <= 1024; size *= 2) {
+        std::vector<std::string> map = random_map(size, size, 42);
+        double cells = double(size) * size;
+
+        size_t before = allocated_bytes;
+        size_t csr_edges = 0;
+        double t_csr = time_ms([&]() {
+            GridGraph graph = build_graph(map);
+            csr_edges = graph.targets.size();
+        });
+        size_t csr_bytes = allocated_bytes - before;
+
+        // El grafo hash va después para que su memoria liberada no afecte al CSR.
+        before = allocated_bytes;
+        size_t hashed_edges = 0;
+        double t_hash = time_ms([&]() {
+            auto graph = build_hashed_graph(map);
+            for (const auto& entry : graph) hashed_edges += entry.second.size();
+        });
+        size_t hash_bytes = allocated_bytes - before;
+
+        if (hashed_edges != csr_edges) std::cerr << "Error: número de aristas distinto" << std::endl;
+        std::cout << size * size << '\t' << t_hash << '\t' << hash_bytes / cells << '\t'
+                  << t_csr << '\t' << csr_bytes / cells << '\n';
+    }
+}
+
+// Enumeración recursiva de day10_parte2.cpp, como referencia.
+uint64_t count_paths_to_nine(uint32_t start, const GridGraph& graph) {
+    if (graph.heights[start] == '9') return 1;
+    uint64_t total_paths = 0;
+    for (const uint32_t* neighbor = graph.begin(start); neighbor != graph.end(start); ++neighbor) {
+        total_paths += count_paths_to_nine(*neighbor, graph);
+    }
+    return total_paths;
+}
+
+// Diagonales de altura creciente: cada '0' tiene cientos de caminos distintos.
+std::vector<std::string> diagonal_map(int size) {
+    std::vector<std::string> map(size, std::string(size, '0'));
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            map[i][j] = '0' + (i + j) % 10;
+        }
+    }
+    return map;
+}
+
+// Recursión frente a la programación dinámica por niveles.
+void bench_ratings() {
+    std::cout << "== ratings (ms) ==\n";
+    std::cout << "cells\trating\trecursive\tdp\n";
+    for (int size = 64; size <= 2048; size *= 2) {
+        GridGraph graph = build_graph(diagonal_map(size));
+        uint64_t recursive = 0, dp = 0;
+        double t_recursive = time_ms([&]() {
+            for (uint32_t node = 0; node < graph.size(); ++node) {
+                if (graph.heights[node] == '0') recursive += count_paths_to_nine(node, graph);
+            }
+        });
+        double t_dp = time_ms([&]() { dp = total_trail_rating(graph); });
+        if (recursive != dp) std::cerr << "Error: las valoraciones no coinciden" << std::endl;
+        std::cout << size * size << '\t' << dp << '\t' << t_recursive << '\t' << t_dp << '\n';
+    }
+}
+
+// BFS de day10_parte1.cpp, como referencia.
+uint64_t bfs(uint32_t start, const GridGraph& graph) {
+    std::vector<uint32_t> queue = {start};
+    std::unordered_map<uint32_t, bool> visited = {{start, true}};
+    uint64_t total = 0;
+    for (size_t k = 0; k < queue.size(); ++k) {
+        uint32_t current = queue[k];
+        if (graph.heights[current] == '9') {
+            ++total;
+            continue;
+        }
+        for (const uint32_t* neighbor = graph.begin(current); neighbor != graph.end(current); ++neighbor) {
+            if (visited.emplace(*neighbor, true).second) queue.push_back(*neighbor);
+        }
+    }
+    return total;
+}
+
+// Diagonales con un 10% de celdas al azar, para que haya cuencas de todos los tamaños.
+std::vector<std::string> noisy_diagonal_map(int size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99), digit(0, 9);
+    std::vector<std::string> map = diagonal_map(size);
+    for (auto& row : map) {
+        for (char& c : row) {
+            if (percent(rng) < 10) c = '0' + digit(rng);
+        }
+    }
+    return map;
+}
+
+// Un BFS por inicio frente a los bitsets de cimas, con lotes pequeños y grandes.
+void bench_scores() {
+    std::cout << "== scores (ms) ==\n";
+    std::cout << "cells\tscore\tbfs\tbitset(1 word)\tbitset(16 words)\n";
+    for (int size = 64; size <= 1024; size *= 2) {
+        GridGraph graph = build_graph(noisy_diagonal_map(size, 5));
+        uint64_t per_start = 0, small = 0, large = 0;
+        double t_bfs = time_ms([&]() {
+            for (uint32_t node = 0; node < graph.size(); ++node) {
+                if (graph.heights[node] == '0') per_start += bfs(node, graph);
+            }
+        });
+        double t_small = time_ms([&]() { small = total_trail_score(graph, 1); });
+        double t_large = time_ms([&]() { large = total_trail_score(graph, 16); });
+        if (per_start != small || small != large) std::cerr << "Error: las puntuaciones no coinciden" << std::endl;
+        std::cout << size * size << '\t' << per_start << '\t' << t_bfs << '\t' << t_small << '\t' << t_large << '\n';
+    }
+}
+
+// Escalado del recorrido de inicios con visitados por épocas, de 1 a max_threads hilos.
+void bench_threads(unsigned max_threads) {
+    std::cout << "== threads (ms) ==\n";
+    GridGraph graph = build_graph(noisy_diagonal_map(1024, 11));
+    uint64_t expected = 0;
+    double t_hashed = time_ms([&]() {
+        for (uint32_t node = 0; node < graph.size(); ++node) {
+            if (graph.heights[node] == '0') expected += bfs(node, graph);
+        }
+    });
+    std::cout << "hash set por búsqueda\t" << t_hashed << '\n';
+
+    auto stamped_bfs = [&](uint32_t start, TrailScratch& scratch) {
+        scratch.queue.clear();
+        scratch.visited.reset();
+        scratch.queue.push_back(start);
+        scratch.visited.visit(start);
+        uint64_t total = 0;
+        for (size_t head = 0; head < scratch.queue.size(); ++head) {
+            uint32_t current = scratch.queue[head];
+            if (graph.heights[current] == '9') {
+                ++total;
+                continue;
+            }
+            for (const uint32_t* neighbor = graph.begin(current); neighbor != graph.end(current); ++neighbor) {
+                if (scratch.visited.visit(*neighbor)) scratch.queue.push_back(*neighbor);
+            }
+        }
+        return total;
+    };
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        uint64_t result = 0;
+        double t = time_ms([&]() { result = parallel_trailheads(graph, threads, stamped_bfs); });
+        if (result != expected) std::cerr << "Error: resultado distinto con " << threads << " hilos" << std::endl;
+        std::cout << threads << " hilos\t" << t << '\n';
+    }
+}
+
+// Detección de aristas: bucle original por dirección frente a las máscaras por fila.
+void bench_stencil() {
+    std::cout << "== stencil (ms) ==\n";
+    std::cout << "cells\tdirections loop\tscalar masks\tsimd masks\n";
+    for (int size = 256; size <= 4096; size *= 2) {
+        std::vector<std::string> map = noisy_diagonal_map(size, 13);
+        std::vector<char> heights;
+        for (const auto& row : map) heights.insert(heights.end(), row.begin(), row.end());
+
+        size_t loop_edges = 0;
+        double t_loop = time_ms([&]() {
+            std::vector<std::pair<int, int>> directions = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    for (const auto& dir : directions) {
+                        int ni = i + dir.first;
+                        int nj = j + dir.second;
+                        if (ni >= 0 && ni < size && nj >= 0 && nj < size && map[ni][nj] == map[i][j] + 1) ++loop_edges;
+                    }
+                }
+            }
+        });
+
+        auto count_edges = [](const EdgeMasks& masks) {
+            size_t edges = 0;
+            for (const auto& direction : masks.bits) {
+                for (uint64_t word : direction) edges += __builtin_popcountll(word);
+            }
+            return edges;
+        };
+        EdgeMasks scalar, simd;
+        double t_scalar = time_ms([&]() { scalar = compute_edge_masks(heights, size, size, false); });
+        double t_simd = time_ms([&]() { simd = compute_edge_masks(heights, size, size, true); });
+        bool same_masks = std::equal(std::begin(scalar.bits), std::end(scalar.bits), std::begin(simd.bits));
+        if (count_edges(scalar) != loop_edges || !same_masks) {
+            std::cerr << "Error: las máscaras no coinciden" << std::endl;
+        }
+        std::cout << size * size << '\t' << t_loop << '\t' << t_scalar << '\t' << t_simd << '\n';
+    }
+}
+
+// Inserción y búsqueda de coordenadas: std::set, std::unordered_set con el
+// NodeHash original y FlatCoordSet. Las búsquedas son mitad aciertos y mitad
+// fallos (celdas desplazadas fuera del mapa). Con NodeHash las cadenas crecen
+// con el lado del mapa, así que a partir de 1024 x 1024 tarda minutos.
+void bench_coords() {
+    std::cout << "== coords ==\n";
+    std::cout << "keys\tcontainer\tinsert ms\tlookup ms\tB/key\n";
+    for (int size = 128; size <= 512; size *= 2) {
+        std::vector<std::pair<int, int>> keys;
+        keys.reserve(static_cast<size_t>(size) * size);
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) keys.push_back({i, j});
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+        double count = keys.size();
+
+        auto report = [&](const char* name, double t_insert, double t_lookup, size_t bytes, size_t found) {
+            if (found != keys.size()) std::cerr << "Error: " << name << " encuentra " << found << " claves" << std::endl;
+            std::cout << keys.size() << '\t' << name << '\t' << t_insert << '\t' << t_lookup << '\t'
+                      << bytes / count << '\n';
+        };
+
+        {
+            size_t before = allocated_bytes;
+            std::set<std::pair<int, int>> tree;
+            double t_insert = time_ms([&]() { for (const auto& key : keys) tree.insert(key); });
+            size_t bytes = allocated_bytes - before;
+            size_t found = 0;
+            double t_lookup = time_ms([&]() {
+                for (const auto& key : keys) {
+                    found += tree.count(key);
+                    found += tree.count({key.first + size, key.second});
+                }
+            });
+            report("std::set", t_insert, t_lookup, bytes, found);
+        }
+        {
+            size_t before = allocated_bytes;
+            std::unordered_set<Node, NodeHash> hashed;
+            double t_insert = time_ms([&]() { for (const auto& key : keys) hashed.insert(Node(key.first, key.second)); });
+            size_t bytes = allocated_bytes - before;
+            size_t found = 0;
+            double t_lookup = time_ms([&]() {
+                for (const auto& key : keys) {
+                    found += hashed.count(Node(key.first, key.second));
+                    found += hashed.count(Node(key.first + size, key.second));
+                }
+            });
+            report("unordered_set", t_insert, t_lookup, bytes, found);
+        }
+        {
+            size_t before = allocated_bytes;
+            FlatCoordSet flat;
+            double t_insert = time_ms([&]() { for (const auto& key : keys) flat.insert(key.first, key.second); });
+            size_t bytes = allocated_bytes - before;
+            size_t found = 0;
+            double t_lookup = time_ms([&]() {
+                for (const auto& key : keys) {
+                    found += flat.contains(key.first, key.second);
+                    found += flat.contains(key.first + size, key.second);
+                }
+            });
+            report("FlatCoordSet", t_insert, t_lookup, bytes, found);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string which = argc > 1 ? argv[1] : "all";
+    if (which == "all" || which == "graph") bench_graph();
+    if (which == "all" || which == "ratings") bench_ratings();
+    if (which == "all" || which == "scores") bench_scores();
+    unsigned max_threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    if (which == "all" || which == "threads") bench_threads(max_threads);
+    if (which == "all" || which == "stencil") bench_stencil();
+    if (which == "all" || which == "coords") bench_coords();
+    return 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "day10_stencil.h"
+
+// Grafo del mapa topográfico en formato CSR (compressed sparse row).
+// Cada celda (i, j) es el nodo i * cols + j; sus vecinos están en
+// targets[offsets[id] .. offsets[id + 1]). Las alturas se guardan en un único
+// buffer contiguo, en lugar de un std::vector por celda dentro de un mapa hash.
+struct GridGraph {
+    int rows = 0;
+    int cols = 0;
+    std::vector<char> heights;      // Altura de cada celda ('0'..'9')
+    std::vector<uint32_t> offsets;  // rows * cols + 1 entradas
+    std::vector<uint32_t> targets;  // Vecinos de todas las celdas, seguidos
+    EdgeMasks masks;                // Aristas por dirección, un bit por celda
+
+    uint32_t id(int i, int j) const { return static_cast<uint32_t>(i) * cols + j; }
+    int row(uint32_t node) const { return node / cols; }
+    int col(uint32_t node) const { return node % cols; }
+    size_t size() const { return heights.size(); }
+
+    // Rango de vecinos de un nodo.
+    const uint32_t* begin(uint32_t node) const { return targets.data() + offsets[node]; }
+    const uint32_t* end(uint32_t node) const { return targets.data() + offsets[node + 1]; }
+};
+
+// Construye el grafo a partir del mapa: una arista de cada celda a los vecinos
+// (arriba, abajo, izquierda, derecha) cuya altura es exactamente una más.
+inline GridGraph build_graph(const std::vector<std::string>& map) {
+    GridGraph graph;
+    graph.rows = map.size();
+    graph.cols = map.empty() ? 0 : map[0].size();
+    int rows = graph.rows;
+    int cols = graph.cols;
+
+    graph.heights.resize(static_cast<size_t>(rows) * cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            graph.heights[graph.id(i, j)] = map[i][j];
+        }
+    }
+
+    // Las comparaciones de alturas se hacen por filas con el kernel vectorizado;
+    // aquí solo se recorren los bits activos de cada celda.
+    graph.masks = compute_edge_masks(graph.heights, rows, cols);
+
+    // Mismo orden de direcciones que el grafo original: derecha, izquierda, abajo, arriba.
+    const int di[4] = {0, 0, 1, -1};
+    const int dj[4] = {1, -1, 0, 0};
+
+    graph.offsets.resize(graph.size() + 1);
+    graph.targets.reserve(graph.size());
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            uint32_t current = graph.id(i, j);
+            graph.offsets[current] = graph.targets.size();
+            unsigned directions = graph.masks.directions(i, j);
+            for (int d = 0; directions != 0; ++d, directions >>= 1) {
+                if (directions & 1) graph.targets.push_back(graph.id(i + di[d], j + dj[d]));
+            }
+        }
+    }
+    graph.offsets[graph.size()] = graph.targets.size();
+    graph.targets.shrink_to_fit();
+    return graph;
+}
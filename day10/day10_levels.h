@@ -0,0 +1,128 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <climits>
+#include "day10_graph.h"
+
+// Las alturas suben exactamente de uno en uno, así que el grafo es un DAG por
+// niveles. Agrupando las celdas por altura se puede recorrer de '9' a '0' una
+// sola vez en lugar de enumerar los caminos uno a uno.
+
+// Celdas de cada altura (levels[0] son los '0', levels[9] los '9').
+// Las celdas que no son dígitos no pertenecen a ningún nivel.
+inline std::vector<std::vector<uint32_t>> height_levels(const GridGraph& graph) {
+    std::vector<std::vector<uint32_t>> levels(10);
+    for (uint32_t node = 0; node < graph.size(); ++node) {
+        int height = graph.heights[node] - '0';
+        if (height >= 0 && height <= 9) levels[height].push_back(node);
+    }
+    return levels;
+}
+
+// paths[v] = número de caminos de v a algún '9'. Se calcula de la altura 9 a
+// la 0: cada celda suma los caminos de sus vecinos, que ya están calculados.
+inline std::vector<uint64_t> paths_to_nine(const GridGraph& graph, const std::vector<std::vector<uint32_t>>& levels) {
+    std::vector<uint64_t> paths(graph.size(), 0);
+    for (uint32_t node : levels[9]) paths[node] = 1;
+    for (int height = 8; height >= 0; --height) {
+        for (uint32_t node : levels[height]) {
+            uint64_t total = 0;
+            for (const uint32_t* neighbor = graph.begin(node); neighbor != graph.end(node); ++neighbor) {
+                total += paths[*neighbor];
+            }
+            paths[node] = total;
+        }
+    }
+    return paths;
+}
+
+// Suma de las valoraciones de los inicios de sendero ('0') de las filas
+// [first_row, last_row); por defecto, de todo el mapa.
+inline uint64_t total_trail_rating(const GridGraph& graph, int first_row = 0, int last_row = INT_MAX) {
+    std::vector<std::vector<uint32_t>> levels = height_levels(graph);
+    std::vector<uint64_t> paths = paths_to_nine(graph, levels);
+    uint64_t result = 0;
+    for (uint32_t node : levels[0]) {
+        if (graph.row(node) >= first_row && graph.row(node) < last_row) result += paths[node];
+    }
+    return result;
+}
+
+// Puntuación total de los inicios de sendero: cuántas cimas distintas alcanza
+// cada '0'. Cada cima recibe un identificador y los conjuntos de cimas
+// alcanzables se propagan cuesta abajo como bitsets, nivel a nivel; la
+// puntuación de un '0' es el popcount de su conjunto.
+// Con muchas cimas se procesan por lotes de batch_words * 64, de modo que la
+// memoria queda acotada; en cada lote solo se visitan las celdas desde las que
+// se llega a alguna cima del lote. Como en total_trail_rating, solo se suman
+// los inicios de las filas [first_row, last_row).
+inline uint64_t total_trail_score(const GridGraph& graph, size_t batch_words = 16, int first_row = 0, int last_row = INT_MAX) {
+    const uint32_t none = UINT32_MAX;
+    std::vector<uint32_t> summits;
+    for (uint32_t node = 0; node < graph.size(); ++node) {
+        if (graph.heights[node] == '9') summits.push_back(node);
+    }
+    if (batch_words == 0) batch_words = 1;
+
+    // Posición de cada celda activa dentro del bitset de su nivel.
+    std::vector<uint32_t> slot(graph.size(), none);
+    std::vector<uint32_t> upper_nodes, lower_nodes;
+    std::vector<uint64_t> upper_bits, lower_bits;
+    const int di[4] = {0, 0, 1, -1};
+    const int dj[4] = {1, -1, 0, 0};
+    const int opposite[4] = {EDGE_LEFT, EDGE_RIGHT, EDGE_UP, EDGE_DOWN};
+
+    uint64_t result = 0;
+    for (size_t first = 0; first < summits.size(); first += batch_words * 64) {
+        size_t batch = std::min(summits.size() - first, batch_words * 64);
+        size_t words = (batch + 63) / 64;
+
+        // Nivel 9: cada cima del lote solo se alcanza a sí misma.
+        upper_nodes.assign(summits.begin() + first, summits.begin() + first + batch);
+        upper_bits.assign(batch * words, 0);
+        for (size_t k = 0; k < batch; ++k) {
+            upper_bits[k * words + k / 64] |= uint64_t(1) << (k % 64);
+        }
+
+        for (char height = '8'; height >= '0' && !upper_nodes.empty(); --height) {
+            lower_nodes.clear();
+            lower_bits.clear();
+            // Cada celda activa pasa su conjunto a los vecinos un nivel más abajo.
+            for (size_t k = 0; k < upper_nodes.size(); ++k) {
+                int i = graph.row(upper_nodes[k]);
+                int j = graph.col(upper_nodes[k]);
+                for (int d = 0; d < 4; ++d) {
+                    int ni = i + di[d];
+                    int nj = j + dj[d];
+                    if (ni < 0 || ni >= graph.rows || nj < 0 || nj >= graph.cols) continue;
+                    // La celda de abajo sube a esta si tiene la arista en la dirección opuesta.
+                    if (!graph.masks.has(opposite[d], ni, nj)) continue;
+                    uint32_t below = graph.id(ni, nj);
+                    if (slot[below] == none) {
+                        slot[below] = lower_nodes.size();
+                        lower_nodes.push_back(below);
+                        lower_bits.resize(lower_bits.size() + words, 0);
+                    }
+                    uint64_t* to = lower_bits.data() + slot[below] * words;
+                    const uint64_t* from = upper_bits.data() + k * words;
+                    for (size_t w = 0; w < words; ++w) to[w] |= from[w];
+                }
+            }
+            for (uint32_t node : lower_nodes) slot[node] = none;
+            upper_nodes.swap(lower_nodes);
+            upper_bits.swap(lower_bits);
+        }
+
+        // Si se llegó al nivel 0, "upper" tiene los conjuntos de los inicios.
+        if (!upper_nodes.empty() && graph.heights[upper_nodes[0]] == '0') {
+            for (size_t k = 0; k < upper_nodes.size(); ++k) {
+                int row = graph.row(upper_nodes[k]);
+                if (row < first_row || row >= last_row) continue;
+                for (size_t w = 0; w < words; ++w) result += __builtin_popcountll(upper_bits[k * words + w]);
+            }
+        }
+    }
+    return result;
+}
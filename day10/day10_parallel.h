@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include "day10_graph.h"
+
+// Conjunto de visitados por "épocas": cada celda guarda la época en la que se
+// visitó por última vez, así que vaciarlo es solo incrementar la época, sin
+// reservar ni limpiar memoria entre búsquedas.
+class VisitedStamps {
+public:
+    explicit VisitedStamps(size_t cells = 0) : stamps_(cells, 0) {}
+
+    // Empieza una búsqueda nueva en O(1).
+    void reset() {
+        if (++epoch_ == 0) {
+            // Tras 2^32 búsquedas la época da la vuelta: se limpia una vez.
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    // Marca la celda; devuelve false si ya estaba visitada en esta búsqueda.
+    bool visit(uint32_t node) {
+        if (stamps_[node] == epoch_) return false;
+        stamps_[node] = epoch_;
+        return true;
+    }
+
+private:
+    std::vector<uint32_t> stamps_;
+    uint32_t epoch_ = 0;
+};
+
+// Memoria de trabajo de un hilo, reutilizada en todas sus búsquedas.
+struct TrailScratch {
+    explicit TrailScratch(size_t cells) : visited(cells) {}
+    VisitedStamps visited;
+    std::vector<uint32_t> queue;
+};
+
+// Ejecuta search(inicio, scratch) desde cada '0' y suma los resultados.
+// Los inicios se reparten en rangos contiguos, uno por hilo; cuando un hilo
+// termina el suyo roba bloques de los rangos de los demás. Si search solo
+// recibe el inicio, los hilos no reservan ningún TrailScratch.
+template <typename Search>
+uint64_t parallel_trailheads(const GridGraph& graph, unsigned num_threads, Search search) {
+    std::vector<uint32_t> trailheads;
+    for (uint32_t node = 0; node < graph.size(); ++node) {
+        if (graph.heights[node] == '0') trailheads.push_back(node);
+    }
+    if (num_threads == 0) num_threads = 1;
+    num_threads = std::max(1u, std::min<unsigned>(num_threads, trailheads.size()));
+
+    // Rango de cada hilo: [next, end). El dueño y los ladrones avanzan "next"
+    // con fetch_add, de "grain" en "grain" inicios.
+    struct Range {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+    std::vector<Range> ranges(num_threads);
+    size_t per_thread = (trailheads.size() + num_threads - 1) / num_threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+        ranges[t].next = std::min(trailheads.size(), t * per_thread);
+        ranges[t].end = std::min(trailheads.size(), (t + 1) * per_thread);
+    }
+    const size_t grain = 64;
+
+    // Llama a visit con cada inicio que consigue el hilo t: primero los de su
+    // rango y después los de los demás hilos.
+    auto claim = [&](unsigned t, auto&& visit) {
+        for (unsigned k = 0; k < num_threads; ++k) {
+            Range& range = ranges[(t + k) % num_threads];
+            for (size_t first = range.next.fetch_add(grain); first < range.end; first = range.next.fetch_add(grain)) {
+                size_t last = std::min(range.end, first + grain);
+                for (size_t i = first; i < last; ++i) {
+                    visit(trailheads[i]);
+                }
+            }
+        }
+    };
+
+    std::vector<uint64_t> partial(num_threads, 0);
+    auto worker = [&](unsigned t) {
+        uint64_t total = 0;
+        if constexpr (std::is_invocable_v<Search&, uint32_t, TrailScratch&>) {
+            TrailScratch scratch(graph.size());
+            claim(t, [&](uint32_t start) { total += search(start, scratch); });
+        } else {
+            claim(t, [&](uint32_t start) { total += search(start); });
+        }
+        partial[t] = total;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : threads) thread.join();
+
+    uint64_t result = 0;
+    for (uint64_t total : partial) result += total;
+    return result;
+}
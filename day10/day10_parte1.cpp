@@ -2,90 +2,36 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
-
-// Estructura para representar un nodo en el grafo.
-struct Node {
-    int x, y; // Coordenadas de la celda en el mapa.
-    Node(int x, int y) : x(x), y(y) {}
-
-    // Operador de comparación para que los nodos puedan ser comparados.
-    bool operator==(const Node& other) const {
-        return x == other.x && y == other.y;
-    }
-};
-
-// Hash personalizado para usar Node en contenedores como unordered_map o unordered_set.
-struct NodeHash {
-    std::size_t operator()(const Node& node) const {
-        // Combina los hashes de las coordenadas x e y.
-        return std::hash<int>()(node.x) ^ (std::hash<int>()(node.y) << 1);
-    }
-};
-
-// Construye un grafo a partir del mapa.
-std::unordered_map<Node, std::vector<Node>, NodeHash> build_graph(const std::vector<std::string>& map) {
-    std::unordered_map<Node, std::vector<Node>, NodeHash> graph;
-    int rows = map.size();
-    int cols = map[0].size();
-
-    // Direcciones para los vecinos (arriba, abajo, izquierda, derecha).
-    std::vector<std::pair<int, int>> directions = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            Node current(i, j); // Nodo actual en el grafo.
-
-            // Recorremos las direcciones posibles para encontrar vecinos.
-            for (const auto& dir : directions) {
-                int ni = i + dir.first;
-                int nj = j + dir.second;
-
-                // Verificamos que los vecinos estén dentro de los límites del mapa.
-                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols) {
-                    // Solo agregamos una conexión si el vecino tiene un valor consecutivo.
-                    if (map[ni][nj] == map[i][j] + 1) {
-                        graph[current].emplace_back(ni, nj);
-                    }
-                }
-            }
-        }
-    }
-
-    return graph;
-}
-
-// Realiza una búsqueda en anchura (BFS) para contar caminos válidos desde un nodo inicial.
-uint64_t bfs(const Node& start, const std::unordered_map<Node, std::vector<Node>, NodeHash>& graph, const std::vector<std::string>& map) {
-    std::queue<Node> q; // Cola para la exploración BFS.
-    std::unordered_set<Node, NodeHash> visited; // Conjunto de nodos visitados.
+#include <cstdint>
+#include "day10_graph.h"
+#include "day10_levels.h"
+#include "day10_parallel.h"
+#include "day10_stream.h"
+
+// Realiza una búsqueda en anchura (BFS) para contar las cimas '9' alcanzables desde un nodo inicial.
+// La cola y los visitados vienen del scratch del hilo y se reutilizan entre búsquedas.
+uint64_t bfs(uint32_t start, const GridGraph& graph, TrailScratch& scratch) {
+    std::vector<uint32_t>& q = scratch.queue; // Cola para la exploración BFS.
     uint64_t total = 0; // Contador de caminos válidos que llegan a '9'.
 
-    q.push(start); // Inicia la exploración desde el nodo dado.
-    visited.insert(start);
+    q.clear();
+    scratch.visited.reset();
+    q.push_back(start); // Inicia la exploración desde el nodo dado.
+    scratch.visited.visit(start);
 
-    while (!q.empty()) {
-        Node current = q.front();
-        q.pop();
+    for (size_t head = 0; head < q.size(); ++head) {
+        uint32_t current = q[head];
 
         // Si alcanzamos un nodo con el valor '9', contamos este camino.
-        if (map[current.x][current.y] == '9') {
+        if (graph.heights[current] == '9') {
             ++total;
             continue; // No exploramos más allá de un nodo '9'.
         }
 
-        // Verificamos si el nodo actual tiene vecinos en el grafo.
-        if (graph.find(current) == graph.end()) {
-            continue;
-        }
-
         // Explorar los vecinos del nodo actual.
-        for (const auto& neighbor : graph.at(current)) {
-            if (visited.find(neighbor) == visited.end()) {
-                visited.insert(neighbor);
-                q.push(neighbor);
+        for (const uint32_t* neighbor = graph.begin(current); neighbor != graph.end(current); ++neighbor) {
+            if (scratch.visited.visit(*neighbor)) {
+                q.push_back(*neighbor);
             }
         }
     }
@@ -93,7 +39,25 @@ uint64_t bfs(const Node& start, const std::unordered_map<Node, std::vector<Node>
     return total;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // ./day10_parte1 [--bitset] [--threads N] [--stream FILAS]
+    // --bitset propaga conjuntos de cimas en lugar de hacer un BFS por inicio;
+    // --threads reparte los inicios entre N hilos;
+    // --stream lee el mapa por bandas de FILAS filas sin cargarlo entero.
+    bool use_bitset = false;
+    unsigned num_threads = 1;
+    int band_rows = 0;
+    for (int k = 1; k < argc; ++k) {
+        std::string arg = argv[k];
+        if (arg == "--bitset") {
+            use_bitset = true;
+        } else if (arg == "--threads" && k + 1 < argc) {
+            num_threads = std::stoul(argv[++k]);
+        } else if (arg == "--stream" && k + 1 < argc) {
+            band_rows = std::stoi(argv[++k]);
+        }
+    }
+
     // Abrir el archivo de entrada.
     std::ifstream file("day10_puzzle.txt");
     if (!file) {
@@ -101,6 +65,17 @@ int main() {
         return 1;
     }
 
+    if (band_rows > 0) {
+        // Bandas horizontales con halo; la memoria depende del alto de banda.
+        TrailTotals totals;
+        if (!stream_trail_totals(file, band_rows, totals, TrailTotal::Score)) {
+            std::cerr << "Error: El mapa tiene filas de longitudes inconsistentes." << std::endl;
+            return 1;
+        }
+        std::cout << "result: " << totals.score << std::endl;
+        return 0;
+    }
+
     std::string line;
     std::vector<std::string> map;
 
@@ -128,14 +103,14 @@ int main() {
 
     uint64_t result = 0;
 
-    // Buscar todas las celdas con '0' y realizar BFS desde esas posiciones.
-    for (int i = 0; i < map.size(); ++i) {
-        for (int j = 0; j < map[i].size(); ++j) {
-            if (map[i][j] == '0') {
-                Node start(i, j);
-                result += bfs(start, graph, map);
-            }
-        }
+    if (use_bitset) {
+        // Conjuntos de cimas alcanzables propagados de '9' a '0'.
+        result = total_trail_score(graph);
+    } else {
+        // Buscar todas las celdas con '0' y realizar BFS desde esas posiciones.
+        result = parallel_trailheads(graph, num_threads, [&](uint32_t start, TrailScratch& scratch) {
+            return bfs(start, graph, scratch);
+        });
     }
 
     // Imprimir el resultado.
@@ -1,93 +1,65 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
-#include <unordered_map>
-#include <unordered_set>
-#include <queue>
 #include <string>
-
-// Estructura para representar un nodo en el grafo.
-struct Node {
-    int x, y;
-    char value;
-
-    Node(int x, int y, char value) : x(x), y(y), value(value) {}
-
-    bool operator==(const Node& other) const {
-        return x == other.x && y == other.y;
-    }
-};
-
-// Hash personalizado para usar Node en unordered_map o unordered_set.
-struct NodeHash {
-    std::size_t operator()(const Node& node) const {
-        return std::hash<int>()(node.x) ^ (std::hash<int>()(node.y) << 1);
-    }
-};
-
-// Función para construir nodos con adyacencias en el grafo.
-std::unordered_map<Node, std::vector<Node>, NodeHash> build_graph(const std::vector<std::string>& map) {
-    std::unordered_map<Node, std::vector<Node>, NodeHash> graph;
-    int rows = map.size();
-    int cols = map[0].size();
-
-    // Direcciones posibles (arriba, abajo, izquierda, derecha).
-    std::vector<std::pair<int, int>> directions = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            Node current(i, j, map[i][j]);
-            for (const auto& dir : directions) {
-                int ni = i + dir.first;
-                int nj = j + dir.second;
-
-                // Verificamos límites y que el valor sea consecutivo.
-                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols) {
-                    if (map[ni][nj] == map[i][j] + 1) {
-                        graph[current].emplace_back(ni, nj, map[ni][nj]);
-                    }
-                }
-            }
-        }
-    }
-
-    return graph;
-}
-
-// Función recursiva para buscar caminos a '9' desde un nodo.
-uint64_t count_paths_to_nine(const Node& start, const std::unordered_map<Node, std::vector<Node>, NodeHash>& graph, std::unordered_set<Node, NodeHash>& visited) {
+#include <cstdint>
+#include "day10_graph.h"
+#include "day10_levels.h"
+#include "day10_parallel.h"
+#include "day10_stream.h"
+
+// Función recursiva para contar los caminos a '9' desde un nodo.
+// Las alturas suben de uno en uno, así que un camino nunca repite celda y no
+// hace falta llevar un conjunto de visitados.
+uint64_t count_paths_to_nine(uint32_t start, const GridGraph& graph) {
     // Si el nodo actual tiene el valor '9', contamos este camino.
-    if (start.value == '9') {
+    if (graph.heights[start] == '9') {
         return 1;
     }
 
-    // Marcamos el nodo como visitado.
-    visited.insert(start);
-
     uint64_t total_paths = 0;
-
-    // Verificamos si el nodo tiene vecinos en el grafo.
-    auto it = graph.find(start); // Usamos find() para evitar errores si el nodo no está.
-    if (it != graph.end()) {
-        for (const auto& neighbor : it->second) {
-            if (visited.find(neighbor) == visited.end()) {
-                total_paths += count_paths_to_nine(neighbor, graph, visited);
-            }
-        }
+    for (const uint32_t* neighbor = graph.begin(start); neighbor != graph.end(start); ++neighbor) {
+        total_paths += count_paths_to_nine(*neighbor, graph);
     }
-
-    // Desmarcamos el nodo al retroceder en la recursión.
-    visited.erase(start);
     return total_paths;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // ./day10_parte2 [--dp] [--threads N] [--stream FILAS]
+    // --dp usa la programación dinámica por niveles;
+    // --threads reparte los inicios entre N hilos;
+    // --stream lee el mapa por bandas de FILAS filas sin cargarlo entero.
+    bool use_dp = false;
+    unsigned num_threads = 1;
+    int band_rows = 0;
+    for (int k = 1; k < argc; ++k) {
+        std::string arg = argv[k];
+        if (arg == "--dp") {
+            use_dp = true;
+        } else if (arg == "--threads" && k + 1 < argc) {
+            num_threads = std::stoul(argv[++k]);
+        } else if (arg == "--stream" && k + 1 < argc) {
+            band_rows = std::stoi(argv[++k]);
+        }
+    }
+
     std::ifstream file("day10_puzzle.txt");
     if (!file) {
         std::cerr << "Error opening the file!" << std::endl;
         return 1;
     }
 
+    if (band_rows > 0) {
+        // Bandas horizontales con halo; la memoria depende del alto de banda.
+        TrailTotals totals;
+        if (!stream_trail_totals(file, band_rows, totals, TrailTotal::Rating)) {
+            std::cerr << "Error: El mapa tiene filas de longitudes inconsistentes." << std::endl;
+            return 1;
+        }
+        std::cout << "result: " << totals.rating << std::endl;
+        return 0;
+    }
+
     std::string line;
     std::vector<std::string> map;
 
@@ -107,15 +79,14 @@ int main() {
 
     uint64_t result = 0;
 
-    // Buscar caminos desde cada nodo '0'.
-    for (int i = 0; i < map.size(); ++i) {
-        for (int j = 0; j < map[i].size(); ++j) {
-            if (map[i][j] == '0') {
-                Node start(i, j, '0');
-                std::unordered_set<Node, NodeHash> visited;
-                result += count_paths_to_nine(start, graph, visited);
-            }
-        }
+    if (use_dp) {
+        // Una sola pasada de '9' a '0' contando caminos por celda.
+        result = total_trail_rating(graph);
+    } else {
+        // Buscar caminos desde cada nodo '0'.
+        result = parallel_trailheads(graph, num_threads, [&](uint32_t start) {
+            return count_paths_to_nine(start, graph);
+        });
     }
 
     std::cout << "result: " << result << std::endl;
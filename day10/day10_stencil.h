@@ -0,0 +1,129 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DAY10_HAS_AVX2_STENCIL 1
+#endif
+
+// Detección vectorizada de aristas cuesta arriba del día 10.
+// Para cada fila se calculan cuatro máscaras de bits, una por dirección, con
+// el bit j activo si la celda (i, j) tiene un vecino en esa dirección con
+// altura exactamente una más. Con AVX2 se comparan 32 celdas de una vez.
+
+// Mismo orden de direcciones que build_graph: derecha, izquierda, abajo, arriba.
+enum EdgeDirection { EDGE_RIGHT = 0, EDGE_LEFT = 1, EDGE_DOWN = 2, EDGE_UP = 3 };
+
+struct EdgeMasks {
+    int rows = 0;
+    int cols = 0;
+    size_t words_per_row = 0;
+    std::vector<uint64_t> bits[4]; // bits[d][i * words_per_row + j / 64]
+
+    bool has(int d, int i, int j) const {
+        return (bits[d][i * words_per_row + j / 64] >> (j % 64)) & 1;
+    }
+
+    // Las cuatro direcciones de una celda en los bits 0..3.
+    unsigned directions(int i, int j) const {
+        size_t word = i * words_per_row + j / 64;
+        int bit = j % 64;
+        return ((bits[EDGE_RIGHT][word] >> bit) & 1) | (((bits[EDGE_LEFT][word] >> bit) & 1) << 1) |
+               (((bits[EDGE_DOWN][word] >> bit) & 1) << 2) | (((bits[EDGE_UP][word] >> bit) & 1) << 3);
+    }
+};
+
+// Copia de las alturas con un borde de ceros, para que las cargas de los
+// vecinos nunca salgan del buffer. El 0 nunca es altura + 1 de un dígito.
+struct PaddedHeights {
+    size_t stride = 0;
+    std::vector<uint8_t> data;
+
+    const uint8_t* cell(int i, int j) const { return data.data() + (i + 1) * stride + (j + 1); }
+};
+
+inline PaddedHeights pad_heights(const std::vector<char>& heights, int rows, int cols) {
+    PaddedHeights padded;
+    // Dos columnas de borde más 32 bytes de holgura para la última carga de la fila.
+    padded.stride = ((cols + 2 + 31) / 32) * 32 + 32;
+    padded.data.assign((rows + 2) * padded.stride, 0);
+    for (int i = 0; i < rows; ++i) {
+        std::memcpy(padded.data.data() + (i + 1) * padded.stride + 1, heights.data() + static_cast<size_t>(i) * cols, cols);
+    }
+    return padded;
+}
+
+// Versión escalar: una celda y una dirección cada vez.
+inline void edge_masks_row_scalar(const PaddedHeights& padded, int i, int cols, uint64_t* out[4]) {
+    const ptrdiff_t offset[4] = {1, -1, static_cast<ptrdiff_t>(padded.stride), -static_cast<ptrdiff_t>(padded.stride)};
+    for (int j = 0; j < cols; ++j) {
+        const uint8_t* current = padded.cell(i, j);
+        uint8_t next_height = *current + 1;
+        for (int d = 0; d < 4; ++d) {
+            if (current[offset[d]] == next_height) out[d][j / 64] |= uint64_t(1) << (j % 64);
+        }
+    }
+}
+
+#ifdef DAY10_HAS_AVX2_STENCIL
+// Versión AVX2: compara la fila con sus desplazamientos y con las filas
+// vecinas en bloques de 32 bytes y guarda las máscaras con movemask.
+__attribute__((target("avx2"))) inline void edge_masks_row_avx2(const PaddedHeights& padded, int i, int cols, uint64_t* out[4]) {
+    const __m256i one = _mm256_set1_epi8(1);
+    for (int j = 0; j < cols; j += 32) {
+        const uint8_t* current = padded.cell(i, j);
+        __m256i next_height = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(current)), one);
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + 1));
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current - 1));
+        __m256i down = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + padded.stride));
+        __m256i up = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current - padded.stride));
+
+        // Bits de las columnas que existen de verdad en este bloque.
+        int valid = cols - j;
+        uint64_t keep = valid >= 32 ? 0xFFFFFFFFull : ((uint64_t(1) << valid) - 1);
+        uint64_t masks[4] = {
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(right, next_height))),
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(left, next_height))),
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(down, next_height))),
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(up, next_height))),
+        };
+        for (int d = 0; d < 4; ++d) {
+            out[d][j / 64] |= (masks[d] & keep) << (j % 64);
+        }
+    }
+}
+#endif
+
+inline bool cpu_has_avx2_stencil() {
+#ifdef DAY10_HAS_AVX2_STENCIL
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+// Calcula las máscaras de todas las filas. use_simd = false fuerza la versión escalar.
+inline EdgeMasks compute_edge_masks(const std::vector<char>& heights, int rows, int cols, bool use_simd = true) {
+    EdgeMasks masks;
+    masks.rows = rows;
+    masks.cols = cols;
+    masks.words_per_row = (cols + 63) / 64;
+    for (auto& direction : masks.bits) direction.assign(rows * masks.words_per_row, 0);
+
+    PaddedHeights padded = pad_heights(heights, rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        uint64_t* out[4];
+        for (int d = 0; d < 4; ++d) out[d] = masks.bits[d].data() + i * masks.words_per_row;
+#ifdef DAY10_HAS_AVX2_STENCIL
+        if (use_simd && cpu_has_avx2_stencil()) {
+            edge_masks_row_avx2(padded, i, cols, out);
+            continue;
+        }
+#endif
+        edge_masks_row_scalar(padded, i, cols, out);
+    }
+    return masks;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <istream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "day10_graph.h"
+#include "day10_levels.h"
+
+// Procesado por bandas horizontales para mapas que no caben en memoria.
+// Un sendero tiene exactamente 9 pasos, así que nunca se aleja más de 9 filas
+// de su '0'. Cada banda de band_rows filas se resuelve con un halo de
+// TRAIL_HALO filas por arriba y por abajo; el halo superior es lo que se
+// arrastra de la banda anterior. La memoria depende de
+// (band_rows + 2 * TRAIL_HALO) * ancho y no del área total.
+constexpr int TRAIL_HALO = 9;
+
+struct TrailTotals {
+    uint64_t score = 0;   // Parte 1: cimas distintas alcanzables desde cada '0'
+    uint64_t rating = 0;  // Parte 2: caminos distintos desde cada '0'
+};
+
+// Qué totales calcula stream_trail_totals; cada parte solo necesita uno.
+enum class TrailTotal { Score, Rating, Both };
+
+// Lee el mapa fila a fila de "in" y acumula los totales pedidos en which.
+// Devuelve false si las filas no tienen todas la misma longitud.
+inline bool stream_trail_totals(std::istream& in, int band_rows, TrailTotals& totals, TrailTotal which = TrailTotal::Both) {
+    if (band_rows < 1) band_rows = 1;
+    std::vector<std::string> window; // Filas [window_first, window_first + window.size())
+    long long window_first = 0;
+    long long core_first = 0;        // Primera fila de la banda actual
+    size_t width = std::string::npos;
+    bool at_end = false;
+    std::string line;
+
+    while (true) {
+        // Completar la ventana hasta el halo inferior de la banda actual.
+        long long wanted = core_first + band_rows + TRAIL_HALO;
+        while (!at_end && window_first + static_cast<long long>(window.size()) < wanted) {
+            if (!std::getline(in, line)) {
+                at_end = true;
+                break;
+            }
+            if (width == std::string::npos) width = line.size();
+            if (line.size() != width) return false;
+            window.push_back(line);
+        }
+        long long window_end = window_first + static_cast<long long>(window.size());
+        if (core_first >= window_end) break;
+
+        // Resolver la banda: solo cuentan los '0' de las filas de la banda.
+        GridGraph graph = build_graph(window);
+        int first_row = static_cast<int>(core_first - window_first);
+        int last_row = static_cast<int>(std::min(core_first + band_rows, window_end) - window_first);
+        if (which != TrailTotal::Rating) totals.score += total_trail_score(graph, 16, first_row, last_row);
+        if (which != TrailTotal::Score) totals.rating += total_trail_rating(graph, first_row, last_row);
+
+        // Avanzar: se conservan las TRAIL_HALO filas anteriores a la nueva banda.
+        core_first += band_rows;
+        long long keep_from = std::min(window_end, std::max(window_first, core_first - TRAIL_HALO));
+        window.erase(window.begin(), window.begin() + (keep_from - window_first));
+        window_first = keep_from;
+    }
+    return true;
+}
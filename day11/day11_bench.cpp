@@ -0,0 +1,215 @@
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include <atomic>
+#include <queue>
+#include <unordered_map>
+#include "day11_rules.h"
+#include "day11_counts.h"
+#include "day11_dag.h"
+#include "day11_parallel.h"
+#include <thread>
+
+// Benchmarks del día 11. Uso: ./day11_bench [rules|graph|threads] [max_hilos]
+
+// Contador de reservas con new, para comparar cuántas hace cada grafo.
+// Es atómico porque también reservan los hilos de bench_threads.
+static std::atomic<size_t> allocations{0};
+
+// Sin noinline, GCC ve malloc y free a través de new y delete y avisa de
+// reservas mezcladas.
+__attribute__((noinline)) void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Impide que el compilador saque del bucle de repeticiones una llamada sin efectos.
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Reglas originales de generate_nodes: bucle de divisiones y std::pow.
+int blink_stone_pow(uint64_t engraving, uint64_t children[2]) {
+    if (engraving == 0) {
+        children[0] = 1;
+        return 1;
+    }
+    int num_digits = 0;
+    for (uint64_t rest = engraving; rest > 0; rest /= 10) num_digits++;
+    if (num_digits % 2 == 0) {
+        uint64_t divisor = static_cast<uint64_t>(std::pow(10, num_digits / 2));
+        children[0] = engraving / divisor;
+        children[1] = engraving % divisor;
+        return 2;
+    }
+    children[0] = engraving * 2024;
+    return 1;
+}
+
+// Árbol original de day11_parte2.cpp, conservado como referencia: un árbol
+// por piedra inicial, un make_unique por nodo y una cola global.
+struct Node {
+    uint64_t engraving;
+    Node* left = nullptr;
+    Node* right = nullptr;
+};
+
+std::queue<std::pair<Node*, int>> node_queue;
+
+Node* tree_child(uint64_t engraving, int level, std::vector<std::unique_ptr<Node>>& nodes,
+                 std::unordered_map<uint64_t, Node*>& seen_nodes) {
+    auto found = seen_nodes.find(engraving);
+    if (found != seen_nodes.end()) return found->second;
+    nodes.push_back(std::make_unique<Node>());
+    nodes.back()->engraving = engraving;
+    seen_nodes[engraving] = nodes.back().get();
+    node_queue.push({nodes.back().get(), level + 1});
+    return nodes.back().get();
+}
+
+void generate_nodes(std::vector<std::unique_ptr<Node>>& nodes, std::unordered_map<uint64_t, Node*>& seen_nodes) {
+    while (!node_queue.empty()) {
+        auto [node, level] = node_queue.front();
+        node_queue.pop();
+        if (level >= 75) continue;
+        uint64_t children[2];
+        int num_children = blink_stone_pow(node->engraving, children);
+        node->left = tree_child(children[0], level, nodes, seen_nodes);
+        if (num_children == 2) node->right = tree_child(children[1], level, nodes, seen_nodes);
+    }
+}
+
+// Valores con entre 1 y 16 cifras repartidas por igual, y algún 0.
+std::vector<uint64_t> random_engravings(size_t n, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> values(n);
+    for (auto& value : values) {
+        int digits = 1 + rng() % 16;
+        value = rng() % POW10.value[digits];
+        if (rng() % 64 == 0) value = 0;
+    }
+    return values;
+}
+
+// Millones de valores por segundo de cada versión de las reglas.
+void bench_rules() {
+    std::cout << "== rules (Mvalues/s) ==\n";
+    const size_t n = 1 << 20;
+    const int reps = 20;
+    std::vector<uint64_t> values = random_engravings(n, 11);
+    std::vector<uint64_t> left(n), right(n);
+    std::vector<uint8_t> has_right(n);
+
+    auto report = [&](const char* name, double ms) {
+        std::cout << name << '\t' << (double(n) * reps / 1e6) / (ms / 1000.0) << '\n';
+    };
+
+    // Las tres versiones escriben los hijos en los mismos buffers; al final
+    // se comparan con los de la versión original.
+    auto scalar_pass = [&](int (*rule)(uint64_t, uint64_t*)) {
+        for (size_t k = 0; k < n; ++k) {
+            uint64_t children[2] = {0, 0};
+            int num_children = rule(values[k], children);
+            left[k] = children[0];
+            right[k] = children[1];
+            has_right[k] = num_children == 2;
+        }
+    };
+    auto checksum = [&]() {
+        uint64_t sum = 0;
+        for (size_t k = 0; k < n; ++k) sum = sum * 31 + left[k] + right[k] * 7 + has_right[k];
+        return sum;
+    };
+
+    report("digit loop + pow", time_ms([&]() { for (int r = 0; r < reps; r++, clobber_memory()) scalar_pass(blink_stone_pow); }));
+    uint64_t expected = checksum();
+    report("constexpr table", time_ms([&]() { for (int r = 0; r < reps; r++, clobber_memory()) scalar_pass(blink_stone); }));
+    if (checksum() != expected) std::cerr << "Error: constexpr table no coincide" << std::endl;
+    report("batched", time_ms([&]() {
+        for (int r = 0; r < reps; r++, clobber_memory()) blink_batch(values.data(), n, left.data(), right.data(), has_right.data());
+    }));
+    if (checksum() != expected) std::cerr << "Error: batched no coincide" << std::endl;
+}
+
+// Construcción del grafo para muchas piedras iniciales: un árbol por piedra
+// frente al grafo compartido. Se cuentan nodos, reservas y tiempo.
+void bench_graph() {
+    std::cout << "== graph ==\n";
+    std::cout << "stones\ttree nodes\ttree allocs\ttree ms\tdag nodes\tdag allocs\tdag ms\n";
+    for (size_t stones = 10; stones <= 1000; stones *= 10) {
+        std::vector<uint64_t> values = random_engravings(stones, 3);
+
+        size_t tree_nodes = 0;
+        size_t before = allocations;
+        double t_tree = time_ms([&]() {
+            for (uint64_t value : values) {
+                std::vector<std::unique_ptr<Node>> nodes;
+                std::unordered_map<uint64_t, Node*> seen_nodes;
+                nodes.push_back(std::make_unique<Node>());
+                nodes.back()->engraving = value;
+                seen_nodes[value] = nodes.back().get();
+                node_queue.push({nodes.back().get(), 0});
+                generate_nodes(nodes, seen_nodes);
+                tree_nodes += nodes.size();
+            }
+        });
+        size_t tree_allocs = allocations - before;
+
+        size_t dag_nodes = 0;
+        before = allocations;
+        double t_dag = time_ms([&]() {
+            StoneDag dag;
+            for (uint64_t value : values) dag.add(value);
+            dag.expand();
+            dag_nodes = dag.size();
+        });
+        size_t dag_allocs = allocations - before;
+
+        std::cout << stones << '\t' << tree_nodes << '\t' << tree_allocs << '\t' << t_tree << '\t'
+                  << dag_nodes << '\t' << dag_allocs << '\t' << t_dag << '\n';
+    }
+}
+
+// Escalado de los parpadeos por fragmentos con 10^5 piedras iniciales
+// distintas; la referencia es blink_counts con un solo hilo.
+void bench_threads(unsigned max_threads) {
+    std::cout << "== threads (75 blinks, 100000 stones) ==\n";
+    std::vector<uint64_t> stones = random_engravings(100000, 5);
+    uint64_t expected = 0;
+    double t_single = time_ms([&]() { expected = blink_counts(stones, 75); });
+    std::cout << "blink_counts\t" << t_single << " ms\n";
+    std::cout << "threads\tms\tspeedup\n";
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        uint64_t total = 0;
+        double t = time_ms([&]() { total = parallel_blink_counts(stones, 75, threads); });
+        if (total != expected) std::cerr << "Error: resultado distinto con " << threads << " hilos" << std::endl;
+        std::cout << threads << '\t' << t << '\t' << t_single / t << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string which = argc > 1 ? argv[1] : "all";
+    if (which == "all" || which == "rules") bench_rules();
+    if (which == "all" || which == "graph") bench_graph();
+    unsigned max_threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    if (which == "all" || which == "threads") bench_threads(max_threads);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "day11_rules.h"
+#include "../common/flat_table.h"
+
+// Motor de parpadeos por frecuencias: el orden de las piedras no importa para
+// contarlas, así que en cada parpadeo basta una tabla valor -> número de
+// piedras con ese valor, y las reglas se aplican una vez por valor distinto.
+// La memoria depende de los valores distintos (unos pocos miles) y no del
+// número de parpadeos.
+
+// Las cantidades se suman saturando: a partir de unos 100 parpadeos el total
+// ya no cabe en 64 bits, y entonces queda en STONE_OVERFLOW en lugar de dar
+// la vuelta. Para más parpadeos, el modo --matrix.
+constexpr uint64_t STONE_OVERFLOW = UINT64_MAX;
+
+inline uint64_t add_stones(uint64_t a, uint64_t b) {
+    uint64_t sum;
+    return __builtin_add_overflow(a, b, &sum) ? STONE_OVERFLOW : sum;
+}
+
+// Tabla valor -> cantidad.
+class StoneCounts {
+public:
+    explicit StoneCounts(size_t expected = 64) : table_(expected) {}
+
+    size_t size() const { return table_.size(); }
+    void clear() { table_.clear(); }
+
+    // Suma count piedras con el valor engraving.
+    void add(uint64_t engraving, uint64_t count) {
+        auto inserted = table_.insert(engraving, count);
+        if (!inserted.second) inserted.first = add_stones(inserted.first, count);
+    }
+
+    // Llama a visit(valor, cantidad) para cada valor distinto.
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        table_.for_each(visit);
+    }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for_each([&](uint64_t, uint64_t count) { sum = add_stones(sum, count); });
+        return sum;
+    }
+
+private:
+    FlatTable<uint64_t, uint64_t> table_;
+};
+
+// Lee los valores separados por espacios de una línea.
+// Devuelve false si hay algo que no es un número.
+inline bool parse_stones(const std::string& line, std::vector<uint64_t>& stones) {
+    std::istringstream in(line);
+    std::string token;
+    while (in >> token) {
+        if (token.find_first_not_of("0123456789") != std::string::npos) return false;
+        stones.push_back(std::stoull(token));
+    }
+    return true;
+}
+
+// Un parpadeo: cada valor de current reparte su cantidad entre sus hijos en next.
+// Los valores se pasan a blink_batch en bloques de STONE_BATCH.
+constexpr size_t STONE_BATCH = 256;
+
+inline void blink_once(const StoneCounts& current, StoneCounts& next) {
+    uint64_t values[STONE_BATCH], counts[STONE_BATCH], left[STONE_BATCH], right[STONE_BATCH];
+    uint8_t has_right[STONE_BATCH];
+    size_t pending = 0;
+    auto flush = [&]() {
+        blink_batch(values, pending, left, right, has_right);
+        for (size_t k = 0; k < pending; ++k) {
+            next.add(left[k], counts[k]);
+            if (has_right[k]) next.add(right[k], counts[k]);
+        }
+        pending = 0;
+    };
+
+    next.clear();
+    current.for_each([&](uint64_t engraving, uint64_t count) {
+        values[pending] = engraving;
+        counts[pending] = count;
+        if (++pending == STONE_BATCH) flush();
+    });
+    flush();
+}
+
+// Número de piedras tras blinks parpadeos, o STONE_OVERFLOW si no cabe en 64 bits.
+// Ninguna piedra desaparece, así que un total saturado ya no baja y se para ahí.
+inline uint64_t blink_counts(const std::vector<uint64_t>& stones, int blinks) {
+    StoneCounts current(stones.size());
+    StoneCounts next(stones.size());
+    for (uint64_t engraving : stones) current.add(engraving, 1);
+    uint64_t total = current.total();
+    for (int level = 0; level < blinks && total != STONE_OVERFLOW; ++level) {
+        blink_once(current, next);
+        std::swap(current, next);
+        total = current.total();
+    }
+    return total;
+}
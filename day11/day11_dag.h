@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "day11_rules.h"
+#include "../common/flat_table.h"
+
+// Grafo de transiciones del día 11, con un nodo por valor distinto.
+// Todas las piedras iniciales (de todas las líneas) comparten el mismo grafo:
+// valores como 0, 1 o 2024 se generan una sola vez. Los nodos viven seguidos
+// en un único vector que solo crece por el final (un arena), y los hijos son
+// índices de 32 bits, que siguen siendo válidos cuando el vector se realoja.
+// Desde cualquier valor inicial se alcanzan solo unos pocos miles de valores,
+// así que el grafo se cierra enseguida y no hace falta limitar la profundidad.
+
+constexpr uint32_t NO_STONE = UINT32_MAX;
+
+struct StoneNode {
+    uint64_t engraving;
+    uint32_t left = NO_STONE;
+    uint32_t right = NO_STONE;
+};
+
+class StoneDag {
+public:
+    explicit StoneDag(size_t expected = 4096) : index_(expected) { nodes_.reserve(expected); }
+
+    size_t size() const { return nodes_.size(); }
+    const StoneNode& operator[](uint32_t id) const { return nodes_[id]; }
+
+    // Índice del nodo con ese valor, creándolo (sin hijos todavía) si no existe.
+    uint32_t add(uint64_t engraving) {
+        auto inserted = index_.insert(engraving, static_cast<uint32_t>(nodes_.size()));
+        if (inserted.second) nodes_.push_back({engraving});
+        return inserted.first;
+    }
+
+    // Calcula los hijos de todos los nodos que aún no los tienen, incluidos los
+    // que aparecen por el camino. Los nodos se crean en orden de anchura, así
+    // que el propio arena hace de cola y se recorre de forma secuencial.
+    void expand() {
+        while (expanded_ < nodes_.size()) {
+            uint64_t children[2];
+            int num_children = blink_stone(nodes_[expanded_].engraving, children);
+            // add puede realojar nodes_: primero los índices, luego la escritura.
+            uint32_t left = add(children[0]);
+            uint32_t right = num_children == 2 ? add(children[1]) : NO_STONE;
+            nodes_[expanded_].left = left;
+            nodes_[expanded_].right = right;
+            expanded_++;
+        }
+    }
+
+private:
+    std::vector<StoneNode> nodes_;
+    FlatTable<uint64_t, uint32_t> index_;  // Valor -> índice del nodo
+    size_t expanded_ = 0;
+};
@@ -0,0 +1,195 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "day11_dag.h"
+
+// Modo matriz de transición para cantidades enormes de parpadeos (10^12 y más).
+//
+// Si A es la matriz del grafo de valores (StoneDag; A[i][j] = cuántas veces j
+// es hijo de i) y v0 el vector inicial valor -> cantidad, el número de piedras
+// tras t parpadeos es s_t = v0 * A^t * 1. Elevar A directamente no sirve: el
+// grafo cerrado tiene unos 4000 nodos y casi todos están en ciclos, así que
+// cada producto de matrices densas son ~6 * 10^10 operaciones.
+//
+// En su lugar se usa que s_t cumple la recurrencia lineal del polinomio mínimo
+// de A (Cayley-Hamilton), de orden <= número de nodos:
+//  1. se calculan 2n + 1 términos parpadeo a parpadeo (A tiene dos hijos por fila);
+//  2. Berlekamp-Massey obtiene la recurrencia más corta (orden ~1400 para el puzzle);
+//  3. s_B se obtiene de x^B mod P(x), calculado por cuadrados sucesivos: O(L^2 log B).
+//
+// El número de piedras tiene del orden de 0.18 * B cifras, así que el resultado
+// se da módulo un primo (Berlekamp-Massey necesita poder dividir).
+
+class ModArith {
+public:
+    explicit ModArith(uint64_t modulus) : modulus_(modulus) {}
+
+    uint64_t modulus() const { return modulus_; }
+    uint64_t reduce(uint64_t a) const { return a % modulus_; }
+
+    uint64_t add(uint64_t a, uint64_t b) const { return a >= modulus_ - b ? a - (modulus_ - b) : a + b; }
+    uint64_t sub(uint64_t a, uint64_t b) const { return a >= b ? a - b : a + (modulus_ - b); }
+    uint64_t mul(uint64_t a, uint64_t b) const {
+        return static_cast<uint64_t>(static_cast<__uint128_t>(a) * b % modulus_);
+    }
+
+    uint64_t power(uint64_t base, uint64_t exponent) const {
+        uint64_t result = reduce(1);
+        base = reduce(base);
+        for (; exponent > 0; exponent >>= 1) {
+            if (exponent & 1) result = mul(result, base);
+            base = mul(base, base);
+        }
+        return result;
+    }
+
+    // Inverso por el pequeño teorema de Fermat (el módulo es primo).
+    uint64_t inverse(uint64_t a) const { return power(a, modulus_ - 2); }
+
+private:
+    uint64_t modulus_;
+};
+
+// Miller-Rabin determinista para 64 bits.
+inline bool is_prime(uint64_t n) {
+    if (n < 2) return false;
+    const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (uint64_t p : bases) {
+        if (n % p == 0) return n == p;
+    }
+    ModArith arith(n);
+    uint64_t odd = n - 1;
+    int twos = 0;
+    while (odd % 2 == 0) {
+        odd /= 2;
+        twos++;
+    }
+    for (uint64_t base : bases) {
+        uint64_t x = arith.power(base, odd);
+        if (x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for (int k = 1; k < twos && composite; ++k) {
+            x = arith.mul(x, x);
+            if (x == n - 1) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// s_0 .. s_{terms-1}: número de piedras tras cada parpadeo.
+inline std::vector<uint64_t> stone_totals(const StoneDag& dag, std::vector<uint64_t> counts, size_t terms, const ModArith& arith) {
+    std::vector<uint64_t> totals, next(counts.size());
+    totals.reserve(terms);
+    for (size_t t = 0; t < terms; ++t) {
+        uint64_t total = 0;
+        for (uint64_t count : counts) total = arith.add(total, count);
+        totals.push_back(total);
+
+        std::fill(next.begin(), next.end(), 0);
+        for (uint32_t id = 0; id < counts.size(); ++id) {
+            if (counts[id] == 0) continue;
+            next[dag[id].left] = arith.add(next[dag[id].left], counts[id]);
+            if (dag[id].right != NO_STONE) next[dag[id].right] = arith.add(next[dag[id].right], counts[id]);
+        }
+        counts.swap(next);
+    }
+    return totals;
+}
+
+// Recurrencia más corta: devuelve c con s_t = c[0] s_{t-1} + ... + c[L-1] s_{t-L}.
+inline std::vector<uint64_t> berlekamp_massey(const std::vector<uint64_t>& s, const ModArith& arith) {
+    std::vector<uint64_t> current = {arith.reduce(1)}, previous = {arith.reduce(1)};
+    size_t length = 0, shift = 1;
+    uint64_t previous_discrepancy = arith.reduce(1);
+    for (size_t i = 0; i < s.size(); ++i) {
+        uint64_t discrepancy = 0;
+        for (size_t j = 0; j <= length && j < current.size(); ++j) {
+            discrepancy = arith.add(discrepancy, arith.mul(current[j], s[i - j]));
+        }
+        if (discrepancy == 0) {
+            shift++;
+            continue;
+        }
+        std::vector<uint64_t> saved = current;
+        uint64_t factor = arith.mul(discrepancy, arith.inverse(previous_discrepancy));
+        if (current.size() < previous.size() + shift) current.resize(previous.size() + shift, 0);
+        for (size_t j = 0; j < previous.size(); ++j) {
+            current[j + shift] = arith.sub(current[j + shift], arith.mul(factor, previous[j]));
+        }
+        if (2 * length <= i) {
+            length = i + 1 - length;
+            previous.swap(saved);
+            previous_discrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    current.resize(length + 1, 0);
+    std::vector<uint64_t> recurrence(length);
+    for (size_t k = 0; k < length; ++k) recurrence[k] = arith.sub(0, current[k + 1]);
+    return recurrence;
+}
+
+// Producto de polinomios reducido módulo x^L - c[0] x^(L-1) - ... - c[L-1].
+inline std::vector<uint64_t> multiply_mod_recurrence(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+                                                      const std::vector<uint64_t>& recurrence, const ModArith& arith) {
+    size_t length = recurrence.size();
+    std::vector<uint64_t> product(2 * length, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] == 0) continue;
+        for (size_t j = 0; j < b.size(); ++j) product[i + j] = arith.add(product[i + j], arith.mul(a[i], b[j]));
+    }
+    // x^k = sum c[m] x^(k-1-m) para k >= L, de mayor a menor grado.
+    for (size_t k = product.size(); k-- > length;) {
+        uint64_t top = product[k];
+        if (top == 0) continue;
+        for (size_t m = 0; m < length; ++m) {
+            product[k - 1 - m] = arith.add(product[k - 1 - m], arith.mul(top, recurrence[m]));
+        }
+    }
+    product.resize(length);
+    return product;
+}
+
+// Número de piedras (módulo el primo modulus) tras blinks parpadeos.
+inline uint64_t blink_count_matrix(const std::vector<uint64_t>& stones, uint64_t blinks, uint64_t modulus) {
+    ModArith arith(modulus);
+    StoneDag dag;
+    std::vector<uint64_t> counts;
+    for (uint64_t engraving : stones) {
+        uint32_t id = dag.add(engraving);
+        if (id >= counts.size()) counts.resize(id + 1, 0);
+        counts[id] = arith.add(counts[id], arith.reduce(1));
+    }
+    dag.expand();
+    counts.resize(dag.size(), 0);
+
+    std::vector<uint64_t> totals = stone_totals(dag, counts, 2 * dag.size() + 1, arith);
+    if (blinks < totals.size()) return totals[blinks];
+
+    std::vector<uint64_t> recurrence = berlekamp_massey(totals, arith);
+    size_t length = recurrence.size();
+    if (length == 0) return 0;
+
+    // x^blinks mod P(x) por cuadrados sucesivos, empezando por x (o por la
+    // constante x^0 si L = 1, donde x ya no es un resto válido).
+    std::vector<uint64_t> result(length, 0), base(length, 0);
+    result[0] = arith.reduce(1);
+    if (length == 1) {
+        base[0] = recurrence[0];
+    } else {
+        base[1] = arith.reduce(1);
+    }
+    for (uint64_t exponent = blinks; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) result = multiply_mod_recurrence(result, base, recurrence, arith);
+        if (exponent > 1) base = multiply_mod_recurrence(base, base, recurrence, arith);
+    }
+
+    uint64_t total = 0;
+    for (size_t k = 0; k < length; ++k) total = arith.add(total, arith.mul(result[k], totals[k]));
+    return total;
+}
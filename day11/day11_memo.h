@@ -0,0 +1,151 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../common/flat_table.h"
+
+// Memoria de resultados del día 11: cuántas piedras salen de un valor cuando
+// quedan "remaining" parpadeos. La clave es el par (valor, parpadeos restantes)
+// y no el nivel desde la raíz, así que sirve para cualquier número total de
+// parpadeos y se puede guardar entre ejecuciones.
+//
+// Es una FlatTable (clave, cantidad); como lleva indicadores de ocupación
+// aparte, un resultado 0 también queda memorizado.
+//
+// Formato del fichero (versión 2, orden de bytes de la máquina):
+//   MemoSnapshotHeader, seguido de los tres arrays de la tabla con capacity
+//   posiciones cada uno: claves (MemoKey), cantidades (uint64_t) y ocupación (uint8_t).
+// Es la tabla tal cual está en memoria, así que al cargarla se proyecta con
+// mmap (MAP_PRIVATE: las inserciones nuevas no tocan el fichero) sin copiarla.
+
+struct MemoKey {
+    uint64_t engraving;
+    uint32_t remaining;
+    uint32_t unused = 0;  // Relleno explícito, para que el fichero no lleve basura
+
+    bool operator==(const MemoKey& other) const {
+        return engraving == other.engraving && remaining == other.remaining;
+    }
+};
+static_assert(sizeof(MemoKey) == 16, "MemoKey forma parte del formato en disco");
+
+struct MemoKeyHash {
+    uint64_t operator()(const MemoKey& key) const {
+        return mix64(key.engraving ^ (static_cast<uint64_t>(key.remaining) * 0x9e3779b97f4a7c15ull));
+    }
+};
+
+struct MemoSnapshotHeader {
+    char magic[8];      // "D11MEMO"
+    uint32_t version;
+    uint32_t entry_size;  // Bytes por posición sumando los tres arrays
+    uint64_t capacity;  // Potencia de dos
+    uint64_t size;      // Entradas ocupadas
+};
+static_assert(sizeof(MemoSnapshotHeader) == 32, "MemoSnapshotHeader forma parte del formato en disco");
+
+constexpr char MEMO_MAGIC[8] = "D11MEMO";
+constexpr uint32_t MEMO_VERSION = 2;
+constexpr uint32_t MEMO_ENTRY_SIZE = sizeof(MemoKey) + sizeof(uint64_t) + sizeof(uint8_t);
+
+class StoneMemo {
+public:
+    explicit StoneMemo(size_t expected = 1024) : table_(expected) {}
+    ~StoneMemo() { unmap(); }
+    StoneMemo(const StoneMemo&) = delete;
+    StoneMemo& operator=(const StoneMemo&) = delete;
+
+    size_t size() const { return table_.size(); }
+
+    // Resultado memorizado o nullptr si no se ha calculado.
+    const uint64_t* find(uint64_t engraving, uint32_t remaining) const {
+        return table_.find(MemoKey{engraving, remaining});
+    }
+
+    // Guarda (o sobrescribe) el resultado de (engraving, remaining).
+    void insert(uint64_t engraving, uint32_t remaining, uint64_t count) {
+        table_.insert(MemoKey{engraving, remaining}).first = count;
+        // Al crecer, la tabla pasa a memoria propia y el fichero ya no hace falta.
+        if (mapping_ && table_.owns_storage()) unmap();
+    }
+
+    // Proyecta un fichero guardado con save. Devuelve false (y deja la memoria
+    // como estaba) si no existe, está truncado, es de otra versión o las
+    // entradas ocupadas no cuadran con la cabecera (lo comprueba adopt).
+    bool load(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        MemoSnapshotHeader header;
+        bool valid = fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(header) &&
+                     pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                     std::memcmp(header.magic, MEMO_MAGIC, sizeof(MEMO_MAGIC)) == 0 &&
+                     header.version == MEMO_VERSION && header.entry_size == MEMO_ENTRY_SIZE &&
+                     header.capacity <= static_cast<uint64_t>(st.st_size) / MEMO_ENTRY_SIZE &&
+                     static_cast<uint64_t>(st.st_size) == sizeof(header) + header.capacity * MEMO_ENTRY_SIZE;
+        if (!valid) {
+            close(fd);
+            return false;
+        }
+        size_t bytes = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return false;
+
+        char* arrays = static_cast<char*>(p) + sizeof(header);
+        size_t capacity = static_cast<size_t>(header.capacity);
+        MemoKey* keys = reinterpret_cast<MemoKey*>(arrays);
+        uint64_t* counts = reinterpret_cast<uint64_t*>(arrays + capacity * sizeof(MemoKey));
+        uint8_t* used = reinterpret_cast<uint8_t*>(arrays + capacity * (sizeof(MemoKey) + sizeof(uint64_t)));
+        if (!table_.adopt(keys, counts, used, capacity, static_cast<size_t>(header.size))) {
+            munmap(p, bytes);
+            return false;
+        }
+        unmap();
+        mapping_ = p;
+        mapping_bytes_ = bytes;
+        return true;
+    }
+
+    // Escribe la tabla en un fichero temporal y lo renombra, para no truncar
+    // un fichero que puede estar proyectado por esta u otra ejecución.
+    bool save(const std::string& path) const {
+        MemoSnapshotHeader header = {};
+        std::memcpy(header.magic, MEMO_MAGIC, sizeof(MEMO_MAGIC));
+        header.version = MEMO_VERSION;
+        header.entry_size = MEMO_ENTRY_SIZE;
+        header.capacity = table_.capacity();
+        header.size = table_.size();
+
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(table_.keys()), table_.capacity() * sizeof(MemoKey));
+            out.write(reinterpret_cast<const char*>(table_.values()), table_.capacity() * sizeof(uint64_t));
+            out.write(reinterpret_cast<const char*>(table_.used()), table_.capacity() * sizeof(uint8_t));
+            if (!out) return false;
+        }
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    void unmap() {
+        if (mapping_) munmap(mapping_, mapping_bytes_);
+        mapping_ = nullptr;
+        mapping_bytes_ = 0;
+    }
+
+    FlatTable<MemoKey, uint64_t, MemoKeyHash> table_;
+    void* mapping_ = nullptr;  // Fichero cargado, mientras la tabla lo use
+    size_t mapping_bytes_ = 0;
+};
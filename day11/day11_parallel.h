@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "day11_rules.h"
+#include "day11_counts.h"
+
+// Parpadeos por frecuencias repartidos entre hilos.
+// La tabla valor -> cantidad se parte en un fragmento (shard) por hilo según
+// el hash del valor, y cada parpadeo tiene dos fases separadas por una barrera:
+//  1. cada hilo aplica las reglas a los valores de su fragmento y deja los
+//     hijos en un buffer por fragmento de destino (outbox[hilo][destino]);
+//  2. cada hilo vacía en su fragmento los buffers que le van dirigidos.
+// Cada buffer tiene un único escritor en la fase 1 y un único lector en la
+// fase 2, así que no hace falta ningún cerrojo aparte de la barrera.
+// Tras la fase 2 cada hilo deja el total de su fragmento en shard_total; si la
+// suma se ha saturado, ya no baja (ninguna piedra desaparece) y se para ahí.
+
+// Barrera reutilizable para un número fijo de hilos.
+class StepBarrier {
+public:
+    explicit StepBarrier(unsigned count) : count_(count) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        unsigned generation = generation_;
+        if (++waiting_ == count_) {
+            waiting_ = 0;
+            generation_++;
+            released_.notify_all();
+            return;
+        }
+        released_.wait(lock, [&] { return generation != generation_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    unsigned count_;
+    unsigned waiting_ = 0;
+    unsigned generation_ = 0;
+};
+
+// Fragmento de un valor: bits altos del hash (StoneCounts usa los bajos para
+// la posición), escalados a [0, shards) con una multiplicación.
+inline unsigned stone_shard(uint64_t engraving, unsigned shards) {
+    return static_cast<unsigned>(((mix64(engraving) >> 32) * shards) >> 32);
+}
+
+inline uint64_t parallel_blink_counts(const std::vector<uint64_t>& stones, int blinks, unsigned num_threads) {
+    if (num_threads == 0) num_threads = 1;
+    const unsigned shards = num_threads;
+    std::vector<StoneCounts> current(shards), next(shards);
+    for (uint64_t engraving : stones) current[stone_shard(engraving, shards)].add(engraving, 1);
+
+    using Outbox = std::vector<std::pair<uint64_t, uint64_t>>;  // (valor, cantidad)
+    std::vector<std::vector<Outbox>> outbox(num_threads, std::vector<Outbox>(shards));
+    std::vector<uint64_t> shard_total(shards);
+    StepBarrier barrier(num_threads);
+
+    auto worker = [&](unsigned t) {
+        uint64_t values[STONE_BATCH], counts[STONE_BATCH], left[STONE_BATCH], right[STONE_BATCH];
+        uint8_t has_right[STONE_BATCH];
+        std::vector<Outbox>& mine = outbox[t];
+
+        for (int level = 0; level < blinks; ++level) {
+            // Todos los hilos ven los mismos shard_total y paran en el mismo nivel.
+            uint64_t total = 0;
+            for (uint64_t count : shard_total) total = add_stones(total, count);
+            if (total == STONE_OVERFLOW) break;
+
+            // Fase 1: reglas sobre el fragmento propio, hijos a los buffers.
+            for (Outbox& box : mine) box.clear();
+            size_t pending = 0;
+            auto flush = [&]() {
+                blink_batch(values, pending, left, right, has_right);
+                for (size_t k = 0; k < pending; ++k) {
+                    mine[stone_shard(left[k], shards)].push_back({left[k], counts[k]});
+                    if (has_right[k]) mine[stone_shard(right[k], shards)].push_back({right[k], counts[k]});
+                }
+                pending = 0;
+            };
+            current[t].for_each([&](uint64_t engraving, uint64_t count) {
+                values[pending] = engraving;
+                counts[pending] = count;
+                if (++pending == STONE_BATCH) flush();
+            });
+            flush();
+            barrier.wait();
+
+            // Fase 2: juntar en el fragmento propio lo que han dejado todos los hilos.
+            next[t].clear();
+            for (unsigned source = 0; source < num_threads; ++source) {
+                for (const auto& child : outbox[source][t]) next[t].add(child.first, child.second);
+            }
+            std::swap(current[t], next[t]);
+            shard_total[t] = current[t].total();
+            barrier.wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    uint64_t total = 0;
+    for (const StoneCounts& shard : current) total = add_stones(total, shard.total());
+    return total;
+}
@@ -1,162 +1,177 @@
 #include <algorithm>
-#include <cmath>
 #include <fstream>
 #include <iostream>
-#include <memory> 
-#include <queue>
 #include <string>
-#include <unordered_map>
 #include <vector>
-
-// Constante que define el nivel máximo de profundidad para el conteo
+#include <climits>
+#include "day11_counts.h"
+#include "day11_memo.h"
+#include "day11_dag.h"
+#include "day11_matrix.h"
+#include "day11_parallel.h"
+#include "day11_service.h"
+
+// Nivel máximo de profundidad por defecto; --blinks lo cambia
 constexpr int MAX_LEVEL = 25;
+int max_level = MAX_LEVEL;
 
-// Estructura que define un nodo en el árbol
-struct Node {
-    long long engraving; // Valor del nodo
-    Node* left = nullptr; // Hijo izquierdo
-    Node* right = nullptr; // Hijo derecho
-};
-
-// Cola global para gestionar los nodos en proceso
-std::queue<std::pair<Node*, int>> node_queue;
-
-// Función para generar nodos del árbol según reglas específicas
-void generate_nodes(std::vector<std::unique_ptr<Node>>& nodes, std::unordered_map<long long, Node*>& seen_nodes) {
-    while (!node_queue.empty()) {
-        auto [node, level] = node_queue.front();
-        node_queue.pop();
-
-        // Limitar la profundidad para evitar procesamiento innecesario
-        if (level >= 75) continue;
-
-        // Calcular el número de dígitos del valor actual
-        int num_digits = 0;
-        {
-            auto engraving = node->engraving;
-            while (engraving > 0) {
-                num_digits++;
-                engraving /= 10;
-            }
-        }
-
-        if (node->engraving == 0) {
-            // Caso: valor 0 -> Crear nodo con valor 1
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = 1;
-
-            if (seen_nodes.find(new_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(new_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[new_node->engraving];
-            }
-        } else if (num_digits % 2 == 0) {
-            // Caso: número de dígitos par -> Dividir en dos mitades
-            long long divisor = static_cast<long long>(std::pow(10, num_digits / 2));
-            
-            // Crear nodo izquierdo con la parte superior de los dígitos
-            auto left_node = std::make_unique<Node>();
-            left_node->engraving = node->engraving / divisor;
-            if (seen_nodes.find(left_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(left_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[left_node->engraving];
-            }
-
-            // Crear nodo derecho con la parte inferior de los dígitos
-            auto right_node = std::make_unique<Node>();
-            right_node->engraving = node->engraving % divisor;
-            if (seen_nodes.find(right_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(right_node));
-                node->right = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->right = seen_nodes[right_node->engraving];
-            }
-        } else {
-            // Caso: número de dígitos impar -> Multiplicar por 2024
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = node->engraving * 2024;
-
-            if (seen_nodes.find(new_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(new_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[new_node->engraving];
-            }
-        }
-    }
-}
+// Grafo de valores compartido por todas las piedras y todas las líneas
+StoneDag dag;
 
-// Almacenamiento en memoria para resultados intermedios (Memoization)
-std::unordered_map<long long, std::unordered_map<int, long long>> memo;
+// Almacenamiento en memoria para resultados intermedios (Memoization),
+// por valor y parpadeos restantes
+StoneMemo memo;
 
 // Función para contar nodos hasta el nivel especificado
-long long count_nodes(Node* node, int level) {
-    if (level == MAX_LEVEL) return 1; // Llegamos al nivel máximo
-    if (memo[node->engraving][level] != 0) return memo[node->engraving][level]; // Usar resultados memorizados
+uint64_t count_nodes(uint32_t id, int level) {
+    if (level == max_level) return 1; // Llegamos al nivel máximo
+    const StoneNode& node = dag[id];
+    int remaining = max_level - level;
+    if (const uint64_t* cached = memo.find(node.engraving, remaining)) return *cached; // Usar resultados memorizados
 
-    long long total = 0;
-    if (node->left != nullptr) total += count_nodes(node->left, level + 1);
-    if (node->right != nullptr) total += count_nodes(node->right, level + 1);
+    uint64_t total = 0;
+    if (node.left != NO_STONE) total = add_stones(total, count_nodes(node.left, level + 1));
+    if (node.right != NO_STONE) total = add_stones(total, count_nodes(node.right, level + 1));
 
-    memo[node->engraving][level] = total; // Memorizar resultado
+    memo.insert(node.engraving, remaining, total); // Memorizar resultado
     return total;
 }
 
 int main(int argc, char* argv[]) {
-    // Leer archivo de entrada
+    // ./day11_parte1 [fichero] [--blinks N] [--counts [--threads N]] [--memo FICHERO] [--matrix [--modulus M]] [--serve | --socket RUTA]
+    // --blinks cambia el número de parpadeos (25 por defecto);
+    // --counts usa la tabla valor -> cantidad en lugar del grafo de nodos;
+    // --threads reparte esa tabla en fragmentos, uno por hilo;
+    // --memo carga la memoización guardada en FICHERO (si existe) y la guarda al terminar.
+    // --matrix usa la matriz de transición (admite billones de parpadeos) y da el
+    // resultado módulo el primo M (1000000007 por defecto).
+    // --serve responde consultas "parpadeos: piedras..." por la entrada estándar, y
+    // --socket lo mismo por un socket Unix; todas comparten la memoización.
     std::string input_file = "day11_puzzle.txt";
-    if (argc > 1) {
-        input_file = argv[1];
+    long long blinks = MAX_LEVEL;
+    bool use_counts = false;
+    bool use_matrix = false;
+    unsigned num_threads = 1;
+    bool serve = false;
+    std::string socket_path;
+    uint64_t modulus = 1000000007;
+    std::string memo_file;
+    for (int k = 1; k < argc; ++k) {
+        std::string arg = argv[k];
+        if (arg == "--blinks" && k + 1 < argc) {
+            blinks = std::stoll(argv[++k]);
+        } else if (arg == "--counts") {
+            use_counts = true;
+        } else if (arg == "--threads" && k + 1 < argc) {
+            num_threads = std::stoul(argv[++k]);
+        } else if (arg == "--serve") {
+            serve = true;
+        } else if (arg == "--socket" && k + 1 < argc) {
+            socket_path = argv[++k];
+        } else if (arg == "--matrix") {
+            use_matrix = true;
+        } else if (arg == "--modulus" && k + 1 < argc) {
+            modulus = std::stoull(argv[++k]);
+        } else if (arg == "--memo" && k + 1 < argc) {
+            memo_file = argv[++k];
+        } else {
+            input_file = arg;
+        }
     }
 
+    if (serve || !socket_path.empty()) {
+        // Servicio de consultas: la latencia de cada una se resume al terminar.
+        SharedStoneMemo shared_memo;
+        LatencyLog latencies;
+        if (!socket_path.empty()) {
+            if (!serve_socket(socket_path, shared_memo, latencies)) {
+                std::cerr << "Error: el socket " << socket_path << " no se ha podido abrir o ha dejado de aceptar conexiones" << std::endl;
+                return 1;
+            }
+        } else {
+            serve_stream(std::cin, std::cout, shared_memo, latencies);
+        }
+        std::cerr << latencies.summary() << std::endl;
+        return 0;
+    }
+
+    if (blinks < 0 || (!use_matrix && blinks > INT_MAX)) {
+        std::cerr << "Error: número de parpadeos no válido (más de " << INT_MAX << " solo con --matrix)" << std::endl;
+        return 1;
+    }
+    // El grafo recurre una vez por parpadeo y memoriza por parpadeo restante,
+    // así que tiene el mismo límite que el servicio.
+    if (!use_counts && !use_matrix && blinks > SERVICE_MAX_BLINKS) {
+        std::cerr << "Error: sin --counts ni --matrix se admiten como mucho " << SERVICE_MAX_BLINKS
+                  << " parpadeos; para más, --counts o --matrix" << std::endl;
+        return 1;
+    }
+    if (use_matrix && !is_prime(modulus)) {
+        std::cerr << "Error: el módulo de --matrix tiene que ser primo" << std::endl;
+        return 1;
+    }
+    max_level = static_cast<int>(std::min<long long>(blinks, INT_MAX));
+
+    if (!memo_file.empty() && !memo.load(memo_file)) {
+        std::cerr << "Aviso: no se ha podido cargar " << memo_file << ", se empieza sin memoización" << std::endl;
+    }
+
+    // Un total saturado no es un resultado: se avisa en lugar de imprimirlo.
+    auto print_total = [](uint64_t total) {
+        if (total == STONE_OVERFLOW) {
+            std::cerr << "Error: el número de piedras no cabe en 64 bits; para tantos parpadeos, --matrix" << std::endl;
+            return false;
+        }
+        std::cout << total << '\n';
+        return true;
+    };
+
     std::ifstream file(input_file);
     std::string line;
 
     while (std::getline(file, line)) {
+        if (use_counts || use_matrix) {
+            std::vector<uint64_t> stones;
+            if (!parse_stones(line, stones)) {
+                std::cerr << "Error: valor no numérico en la línea: " << line << std::endl;
+                return 1;
+            }
+            if (use_matrix) {
+                std::cout << blink_count_matrix(stones, blinks, modulus) << '\n';
+            } else if (num_threads > 1) {
+                if (!print_total(parallel_blink_counts(stones, max_level, num_threads))) return 1;
+            } else {
+                if (!print_total(blink_counts(stones, max_level))) return 1;
+            }
+            continue;
+        }
+
         // Parsear los valores de entrada
-        std::vector<std::unique_ptr<Node>> nodes;
+        std::vector<uint32_t> stones;
         size_t current = 0;
         size_t next_space = line.find(' ');
 
         while (next_space != std::string::npos) {
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = std::stoll(line.substr(current, next_space - current));
-            nodes.push_back(std::move(new_node));
+            stones.push_back(dag.add(std::stoll(line.substr(current, next_space - current))));
             current = next_space + 1;
             next_space = line.find(' ', current);
         }
 
-        auto new_node = std::make_unique<Node>();
-        new_node->engraving = std::stoll(line.substr(current));
-        nodes.push_back(std::move(new_node));
+        stones.push_back(dag.add(std::stoll(line.substr(current))));
+        dag.expand();
 
         // Calcular el resultado
-        long long answer = 0;
-        for (auto& node : nodes) {
-            std::vector<std::unique_ptr<Node>> temp_nodes;
-            temp_nodes.push_back(std::move(node));
-
-            std::unordered_map<long long, Node*> seen_nodes;
-            seen_nodes[temp_nodes.back()->engraving] = temp_nodes.back().get();
-
-            node_queue.push({temp_nodes.back().get(), 0});
-            generate_nodes(temp_nodes, seen_nodes);
-
-            answer += count_nodes(temp_nodes[0].get(), 0);
+        uint64_t answer = 0;
+        for (uint32_t stone : stones) {
+            answer = add_stones(answer, count_nodes(stone, 0));
         }
 
-        std::cout << answer << '\n';
+        if (!print_total(answer)) return 1;
+    }
+
+    if (!memo_file.empty() && !memo.save(memo_file)) {
+        std::cerr << "Error: no se ha podido guardar " << memo_file << std::endl;
+        return 1;
     }
 
     return 0;
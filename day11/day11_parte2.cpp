@@ -1,165 +1,180 @@
 #include <algorithm>
-#include <cmath>
 #include <fstream>
 #include <iostream>
-#include <memory> 
-#include <queue>
 #include <string>
-#include <unordered_map>
 #include <vector>
-
+#include <climits>
+#include "day11_counts.h"
+#include "day11_memo.h"
+#include "day11_dag.h"
+#include "day11_matrix.h"
+#include "day11_parallel.h"
+#include "day11_service.h"
+
+// Número de parpadeos por defecto; --blinks lo cambia
 constexpr int MAX_LEVEL = 75;
+int max_level = MAX_LEVEL;
 
-// Estructura que representa un nodo en el árbol
-struct Node {
-    long long engraving; // Cambiado de "value" a "engraving"
-    Node* left;
-    Node* right; 
-};
-
-// Cola para gestionar los nodos pendientes de procesar
-std::queue<std::pair<Node*, int>> node_queue;
-
-// Función para procesar los nodos y generar nuevos nodos según las reglas
-void generate_nodes(std::vector<std::unique_ptr<Node>>& nodes, std::unordered_map<long long, Node*>& seen_nodes) {
-    while (!node_queue.empty()) {
-        auto [node, level] = node_queue.front();
-        node_queue.pop();
-
-        // Si se alcanza el nivel máximo, no procesar más
-        if (level >= MAX_LEVEL) continue;
-
-        // Contar la cantidad de dígitos en el valor del nodo
-        int num_digits = 0;
-        long long engraving = node->engraving;
-        while (engraving > 0) {
-            num_digits++;
-            engraving /= 10;
-        }
-
-        // Si el valor es 0, crear un nuevo nodo con valor 1
-        if (node->engraving == 0) {
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = 1;
-
-            if (seen_nodes.find(new_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(new_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[new_node->engraving];
-            }
-        } 
-        // Si el número de dígitos es par, dividir el valor en dos partes
-        else if (num_digits % 2 == 0) {
-            // Crear nodo para la parte izquierda (dígitos más significativos)
-            auto left_node = std::make_unique<Node>();
-            left_node->engraving = node->engraving / static_cast<long long>(std::pow(10, num_digits / 2));
-
-            if (seen_nodes.find(left_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(left_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[left_node->engraving];
-            }
-
-            // Crear nodo para la parte derecha (dígitos menos significativos)
-            auto right_node = std::make_unique<Node>();
-            right_node->engraving = node->engraving % static_cast<long long>(std::pow(10, num_digits / 2));
-
-            if (seen_nodes.find(right_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(right_node));
-                node->right = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->right = seen_nodes[right_node->engraving];
-            }
-        } 
-        // Si el número de dígitos es impar, multiplicar por 2024
-        else {
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = node->engraving * 2024;
-
-            if (seen_nodes.find(new_node->engraving) == seen_nodes.end()) {
-                nodes.push_back(std::move(new_node));
-                node->left = nodes.back().get();
-                seen_nodes[nodes.back()->engraving] = nodes.back().get();
-                node_queue.push({nodes.back().get(), level + 1});
-            } else {
-                node->left = seen_nodes[new_node->engraving];
-            }
-        }
-    }
-}
+// Grafo de valores compartido por todas las piedras y todas las líneas
+StoneDag dag;
 
-// Memoria para memoización de los cálculos
-std::unordered_map<long long, std::unordered_map<int, long long>> memo;
+// Memoria para memoización de los cálculos, por valor y parpadeos restantes
+StoneMemo memo;
 
 // Función recursiva para contar los caminos en el árbol
-long long count_nodes(Node* node, int level) {
-    if (level == MAX_LEVEL) return 1; // Base: se alcanzó el nivel máximo
+uint64_t count_nodes(uint32_t id, int level) {
+    if (level == max_level) return 1; // Base: se alcanzó el nivel máximo
+    const StoneNode& node = dag[id];
 
     // Si ya está memorizado, devolver el resultado almacenado
-    if (memo[node->engraving][level] != 0) 
-        return memo[node->engraving][level];
+    int remaining = max_level - level;
+    if (const uint64_t* cached = memo.find(node.engraving, remaining))
+        return *cached;
 
-    long long total = 0;
-    if (node->left) total += count_nodes(node->left, level + 1);
-    if (node->right) total += count_nodes(node->right, level + 1);
+    uint64_t total = 0;
+    if (node.left != NO_STONE) total = add_stones(total, count_nodes(node.left, level + 1));
+    if (node.right != NO_STONE) total = add_stones(total, count_nodes(node.right, level + 1));
 
-    memo[node->engraving][level] = total;
+    memo.insert(node.engraving, remaining, total);
     return total;
 }
 
 int main(int argc, char* argv[]) {
-    // Leer el archivo de entrada
+    // ./day11_parte2 [fichero] [--blinks N] [--counts [--threads N]] [--memo FICHERO] [--matrix [--modulus M]] [--serve | --socket RUTA]
+    // --blinks cambia el número de parpadeos (75 por defecto);
+    // --counts usa la tabla valor -> cantidad en lugar del grafo de nodos;
+    // --threads reparte esa tabla en fragmentos, uno por hilo;
+    // --memo carga la memoización guardada en FICHERO (si existe) y la guarda al terminar.
+    // --matrix usa la matriz de transición (admite billones de parpadeos) y da el
+    // resultado módulo el primo M (1000000007 por defecto).
+    // --serve responde consultas "parpadeos: piedras..." por la entrada estándar, y
+    // --socket lo mismo por un socket Unix; todas comparten la memoización.
     std::string input_file = "day11_puzzle.txt";
-    if (argc > 1) {
-        input_file = argv[1];
+    long long blinks = MAX_LEVEL;
+    bool use_counts = false;
+    bool use_matrix = false;
+    unsigned num_threads = 1;
+    bool serve = false;
+    std::string socket_path;
+    uint64_t modulus = 1000000007;
+    std::string memo_file;
+    for (int k = 1; k < argc; ++k) {
+        std::string arg = argv[k];
+        if (arg == "--blinks" && k + 1 < argc) {
+            blinks = std::stoll(argv[++k]);
+        } else if (arg == "--counts") {
+            use_counts = true;
+        } else if (arg == "--threads" && k + 1 < argc) {
+            num_threads = std::stoul(argv[++k]);
+        } else if (arg == "--serve") {
+            serve = true;
+        } else if (arg == "--socket" && k + 1 < argc) {
+            socket_path = argv[++k];
+        } else if (arg == "--matrix") {
+            use_matrix = true;
+        } else if (arg == "--modulus" && k + 1 < argc) {
+            modulus = std::stoull(argv[++k]);
+        } else if (arg == "--memo" && k + 1 < argc) {
+            memo_file = argv[++k];
+        } else {
+            input_file = arg;
+        }
     }
 
+    if (serve || !socket_path.empty()) {
+        // Servicio de consultas: la latencia de cada una se resume al terminar.
+        SharedStoneMemo shared_memo;
+        LatencyLog latencies;
+        if (!socket_path.empty()) {
+            if (!serve_socket(socket_path, shared_memo, latencies)) {
+                std::cerr << "Error: el socket " << socket_path << " no se ha podido abrir o ha dejado de aceptar conexiones" << std::endl;
+                return 1;
+            }
+        } else {
+            serve_stream(std::cin, std::cout, shared_memo, latencies);
+        }
+        std::cerr << latencies.summary() << std::endl;
+        return 0;
+    }
+
+    if (blinks < 0 || (!use_matrix && blinks > INT_MAX)) {
+        std::cerr << "Error: número de parpadeos no válido (más de " << INT_MAX << " solo con --matrix)" << std::endl;
+        return 1;
+    }
+    // El grafo recurre una vez por parpadeo y memoriza por parpadeo restante,
+    // así que tiene el mismo límite que el servicio.
+    if (!use_counts && !use_matrix && blinks > SERVICE_MAX_BLINKS) {
+        std::cerr << "Error: sin --counts ni --matrix se admiten como mucho " << SERVICE_MAX_BLINKS
+                  << " parpadeos; para más, --counts o --matrix" << std::endl;
+        return 1;
+    }
+    if (use_matrix && !is_prime(modulus)) {
+        std::cerr << "Error: el módulo de --matrix tiene que ser primo" << std::endl;
+        return 1;
+    }
+    max_level = static_cast<int>(std::min<long long>(blinks, INT_MAX));
+
+    if (!memo_file.empty() && !memo.load(memo_file)) {
+        std::cerr << "Aviso: no se ha podido cargar " << memo_file << ", se empieza sin memoización" << std::endl;
+    }
+
+    // Un total saturado no es un resultado: se avisa en lugar de imprimirlo.
+    auto print_total = [](uint64_t total) {
+        if (total == STONE_OVERFLOW) {
+            std::cerr << "Error: el número de piedras no cabe en 64 bits; para tantos parpadeos, --matrix" << std::endl;
+            return false;
+        }
+        std::cout << total << '\n';
+        return true;
+    };
+
     std::ifstream file(input_file);
     std::string line;
 
     while (std::getline(file, line)) {
-        std::vector<std::unique_ptr<Node>> nodes;
+        if (use_counts || use_matrix) {
+            std::vector<uint64_t> stones;
+            if (!parse_stones(line, stones)) {
+                std::cerr << "Error: valor no numérico en la línea: " << line << std::endl;
+                return 1;
+            }
+            if (use_matrix) {
+                std::cout << blink_count_matrix(stones, blinks, modulus) << '\n';
+            } else if (num_threads > 1) {
+                if (!print_total(parallel_blink_counts(stones, max_level, num_threads))) return 1;
+            } else {
+                if (!print_total(blink_counts(stones, max_level))) return 1;
+            }
+            continue;
+        }
+
+        std::vector<uint32_t> stones;
         size_t current_pos = 0;
         size_t next_space = line.find(' ');
 
-        // Crear nodos iniciales a partir de los números en la línea
+        // Añadir al grafo los valores iniciales de la línea
         while (next_space != std::string::npos) {
-            auto new_node = std::make_unique<Node>();
-            new_node->engraving = std::stoll(line.substr(current_pos, next_space - current_pos));
-            nodes.push_back(std::move(new_node));
+            stones.push_back(dag.add(std::stoll(line.substr(current_pos, next_space - current_pos))));
             current_pos = next_space + 1;
             next_space = line.find(' ', current_pos);
         }
 
-        auto last_node = std::make_unique<Node>();
-        last_node->engraving = std::stoll(line.substr(current_pos));
-        nodes.push_back(std::move(last_node));
+        stones.push_back(dag.add(std::stoll(line.substr(current_pos))));
+        dag.expand();
 
-        long long total_nodes = 0;
+        uint64_t total_nodes = 0;
 
-        // Procesar cada nodo inicial
-        for (auto& node : nodes) {
-            std::vector<std::unique_ptr<Node>> tree_nodes;
-            tree_nodes.push_back(std::move(node));
-
-            std::unordered_map<long long, Node*> seen_nodes;
-            node_queue = {};
-            node_queue.push({tree_nodes.back().get(), 0});
-            seen_nodes[tree_nodes.back()->engraving] = tree_nodes.back().get();
-
-            generate_nodes(tree_nodes, seen_nodes);
-            total_nodes += count_nodes(tree_nodes[0].get(), 0);
+        // Procesar cada piedra inicial
+        for (uint32_t stone : stones) {
+            total_nodes = add_stones(total_nodes, count_nodes(stone, 0));
         }
 
-        std::cout << total_nodes << '\n';
+        if (!print_total(total_nodes)) return 1;
+    }
+
+    if (!memo_file.empty() && !memo.save(memo_file)) {
+        std::cerr << "Error: no se ha podido guardar " << memo_file << std::endl;
+        return 1;
     }
 
     return 0;
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Reglas de una piedra al parpadear:
+//   0                   -> 1
+//   número par de cifras -> mitad izquierda y mitad derecha de las cifras
+//   en otro caso        -> valor * 2024
+// Las potencias de diez salen de una tabla calculada en compilación, en lugar
+// de std::pow en coma flotante, y las cifras se cuentan sin bucle.
+
+struct Pow10Table {
+    uint64_t value[20];
+};
+
+constexpr Pow10Table make_pow10_table() {
+    Pow10Table table = {};
+    uint64_t power = 1;
+    for (int k = 0; k < 20; ++k) {
+        table.value[k] = power;
+        power *= 10;
+    }
+    return table;
+}
+
+// POW10.value[k] = 10^k para k = 0..19 (10^19 todavía cabe en 64 bits).
+constexpr Pow10Table POW10 = make_pow10_table();
+static_assert(POW10.value[19] == 10000000000000000000ull, "tabla de potencias de diez");
+
+// Recíprocos de 10^k para dividir con una multiplicación de 128 bits:
+// v / 10^k == (v * magic[k]) >> shift[k] siempre que v < 10^(2k), que es el
+// único caso en que se parte un valor (tiene 2k cifras). Con
+// magic = floor(2^shift / 10^k) + 1 el error es v * 10^k / 2^shift < 1 / 10^k,
+// así que basta con 2^shift >= 10^(3k). El desplazamiento es al menos 64 para
+// quedarse con la mitad alta del producto y desplazarla poco.
+// Con k = 0 (una cifra) nunca se parte y la entrada no se usa. Para k = 10 el
+// recíproco ya no cabe en 64 bits y esos valores (20 cifras) se dividen de verdad.
+struct Div10Table {
+    uint64_t magic[11];
+    int shift[11];  // Desplazamiento de la mitad alta (shift total - 64)
+};
+
+constexpr Div10Table make_div10_table() {
+    Div10Table table = {};
+    for (int k = 1; k < 10; ++k) {
+        __uint128_t cube = 1;
+        for (int m = 0; m < 3 * k; ++m) cube *= 10;
+        int shift = 64;
+        while ((__uint128_t(1) << shift) < cube) shift++;
+        table.magic[k] = static_cast<uint64_t>((__uint128_t(1) << shift) / POW10.value[k] + 1);
+        table.shift[k] = shift - 64;
+    }
+    return table;
+}
+
+constexpr Div10Table DIV10 = make_div10_table();
+
+// Número de cifras decimales; 0 tiene 0 cifras, como el bucle original.
+// bits * 1233 / 4096 aproxima bits * log10(2) y una comparación con la
+// tabla corrige el redondeo.
+inline int digit_count(uint64_t engraving) {
+    int bits = 64 - __builtin_clzll(engraving | 1);
+    int approx = (bits * 1233) >> 12;
+    return approx + 1 - (engraving < POW10.value[approx]);
+}
+
+// Escribe los hijos en children y devuelve cuántos hay (1 o 2).
+inline int blink_stone(uint64_t engraving, uint64_t children[2]) {
+    if (engraving == 0) {
+        children[0] = 1;
+        return 1;
+    }
+    int num_digits = digit_count(engraving);
+    if (num_digits % 2 == 0) {
+        uint64_t divisor = POW10.value[num_digits / 2];
+        children[0] = engraving / divisor;
+        children[1] = engraving % divisor;
+        return 2;
+    }
+    children[0] = engraving * 2024;
+    return 1;
+}
+
+// Versión por lotes: aplica las reglas a values[0..n) y deja el primer hijo
+// en left, el segundo en right y si existe en has_right (0 o 1). Las tres
+// reglas se calculan siempre y se combinan con máscaras, y la división se
+// hace con los recíprocos de DIV10, así que el coste no depende de la regla ni
+// hay saltos que predecir. Solo los valores de 20 cifras toman un salto
+// (nunca aparecen en la práctica).
+inline void blink_batch(const uint64_t* values, size_t n, uint64_t* left, uint64_t* right, uint8_t* has_right) {
+    for (size_t k = 0; k < n; ++k) {
+        uint64_t engraving = values[k];
+        int num_digits = digit_count(engraving);
+        int half = num_digits >> 1;
+        bool zero = engraving == 0;
+        bool split = !zero && (num_digits & 1) == 0;
+        uint64_t divisor = POW10.value[half];
+        uint64_t product_high = static_cast<uint64_t>((static_cast<__uint128_t>(engraving) * DIV10.magic[half]) >> 64);
+        uint64_t high = product_high >> DIV10.shift[half];
+        if (__builtin_expect(num_digits == 20, 0)) high = engraving / divisor;
+        uint64_t low = engraving - high * divisor;
+        // Máscaras de todo unos o todo ceros: con ?: el compilador pone saltos.
+        uint64_t split_mask = 0 - static_cast<uint64_t>(split);
+        uint64_t zero_mask = 0 - static_cast<uint64_t>(zero);
+        uint64_t first = (high & split_mask) | (engraving * 2024 & ~split_mask);
+        left[k] = (1 & zero_mask) | (first & ~zero_mask);
+        right[k] = low & split_mask;
+        has_right[k] = split;
+    }
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include <vector>
+#include <list>
+#include <string>
+#include <array>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "day11_rules.h"
+#include "day11_counts.h"
+#include "day11_memo.h"
+
+// Servicio de consultas del día 11: un proceso que responde muchas consultas
+// seguidas compartiendo una única memoización, así que cada consulta
+// aprovecha lo que calcularon las anteriores.
+//
+// Protocolo, una línea por consulta y una línea por respuesta:
+//   "75: 125 17"  -> número de piedras tras 75 parpadeos de "125 17"
+//   "stats"       -> percentiles de latencia de las consultas respondidas
+//   "shutdown"    -> (solo por socket) deja de aceptar conexiones
+// Los errores se responden con una línea "error: ...", incluido el de un
+// resultado que no cabe en 64 bits (a partir de unos 100 parpadeos).
+
+// Como mucho tantos parpadeos por consulta: la memoización guarda una entrada
+// por valor y parpadeo restante, y la recursión tiene esa profundidad.
+// Para más, el modo --matrix.
+constexpr int SERVICE_MAX_BLINKS = 1000;
+
+// StoneMemo repartida en fragmentos con un cerrojo cada uno, para que varios
+// hilos la usen a la vez sin esperar casi nunca.
+class SharedStoneMemo {
+public:
+    bool find(uint64_t engraving, uint32_t remaining, uint64_t& count) {
+        Shard& shard = shard_for(engraving);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const uint64_t* cached = shard.memo.find(engraving, remaining);
+        if (cached) count = *cached;
+        return cached != nullptr;
+    }
+
+    void insert(uint64_t engraving, uint32_t remaining, uint64_t count) {
+        Shard& shard = shard_for(engraving);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.memo.insert(engraving, remaining, count);
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.memo.size();
+        }
+        return total;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        StoneMemo memo;
+    };
+
+    Shard& shard_for(uint64_t engraving) { return shards_[mix64(engraving) >> 58]; }
+
+    std::array<Shard, 64> shards_;
+};
+
+// Piedras que salen de engraving tras remaining parpadeos, o STONE_OVERFLOW si
+// no caben en 64 bits. El cálculo se hace sin cerrojo; si dos hilos calculan
+// lo mismo a la vez, guardan el mismo valor.
+inline uint64_t shared_stone_count(SharedStoneMemo& memo, uint64_t engraving, uint32_t remaining) {
+    if (remaining == 0) return 1;
+    uint64_t total = 0;
+    if (memo.find(engraving, remaining, total)) return total;
+    uint64_t children[2];
+    int num_children = blink_stone(engraving, children);
+    for (int k = 0; k < num_children; ++k) total = add_stones(total, shared_stone_count(memo, children[k], remaining - 1));
+    memo.insert(engraving, remaining, total);
+    return total;
+}
+
+// Latencias de las consultas, en microsegundos.
+class LatencyLog {
+public:
+    void record(double microseconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_.push_back(microseconds);
+    }
+
+    // "queries N p50 .. p90 .. p99 .. max .. us", por rango más cercano.
+    std::string summary() {
+        std::vector<double> sorted;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sorted = samples_;
+        }
+        std::ostringstream out;
+        out << "queries " << sorted.size();
+        if (sorted.empty()) return out.str();
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double p) {
+            size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        };
+        out << " p50 " << percentile(50) << " p90 " << percentile(90) << " p99 " << percentile(99)
+            << " max " << sorted.back() << " us";
+        return out.str();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<double> samples_;
+};
+
+// Responde una línea "parpadeos: piedras...".
+inline std::string answer_query(const std::string& line, SharedStoneMemo& memo, LatencyLog& log) {
+    auto start = std::chrono::steady_clock::now();
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) return "error: se esperaba \"parpadeos: piedras...\"";
+    std::string blinks_text = line.substr(0, colon);
+    blinks_text.erase(0, blinks_text.find_first_not_of(' '));
+    blinks_text.erase(blinks_text.find_last_not_of(' ') + 1);
+    if (blinks_text.empty() || blinks_text.size() > 9 || blinks_text.find_first_not_of("0123456789") != std::string::npos) {
+        return "error: número de parpadeos no válido";
+    }
+    int blinks = std::stoi(blinks_text);
+    if (blinks > SERVICE_MAX_BLINKS) {
+        return "error: como mucho " + std::to_string(SERVICE_MAX_BLINKS) + " parpadeos por consulta";
+    }
+    std::vector<uint64_t> stones;
+    if (!parse_stones(line.substr(colon + 1), stones)) return "error: valor no numérico";
+
+    uint64_t total = 0;
+    for (uint64_t engraving : stones) total = add_stones(total, shared_stone_count(memo, engraving, blinks));
+    auto end = std::chrono::steady_clock::now();
+    log.record(std::chrono::duration<double, std::micro>(end - start).count());
+    if (total == STONE_OVERFLOW) return "error: overflow, el número de piedras no cabe en 64 bits";
+    return std::to_string(total);
+}
+
+// Consultas por un flujo (la entrada estándar), una detrás de otra.
+inline void serve_stream(std::istream& in, std::ostream& out, SharedStoneMemo& memo, LatencyLog& log) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        if (line == "stats") {
+            out << log.summary() << std::endl;
+        } else {
+            out << answer_query(line, memo, log) << std::endl;
+        }
+    }
+}
+
+// Consultas por un socket Unix en path, con un hilo por conexión y la misma
+// memoización para todas. Termina cuando una conexión envía "shutdown",
+// cortando las conexiones que sigan abiertas aunque estén esperando.
+// Devuelve false si no se ha podido abrir el socket o si accept falla con un
+// error del que no se puede recuperar.
+inline bool serve_socket(const std::string& path, SharedStoneMemo& memo, LatencyLog& log) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    std::strcpy(address.sun_path, path.c_str());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) return false;
+    unlink(path.c_str());
+    if (bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server, 16) != 0) {
+        close(server);
+        return false;
+    }
+
+    std::atomic<bool> stopping{false};
+    // Con MSG_NOSIGNAL, escribir a un cliente que ya ha cerrado da EPIPE en
+    // lugar de SIGPIPE (que terminaría el servicio); solo se cierra esa conexión.
+    auto send_line = [](int client, const std::string& text) {
+        std::string line = text + '\n';
+        for (size_t sent = 0; sent < line.size();) {
+            ssize_t n = send(client, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += n;
+        }
+        return true;
+    };
+    auto handle = [&](int client) {
+        std::string buffer;
+        char chunk[4096];
+        bool open = true;
+        while (open) {
+            ssize_t n = read(client, chunk, sizeof(chunk));
+            if (n <= 0) break;
+            buffer.append(chunk, n);
+            size_t newline;
+            while (open && (newline = buffer.find('\n')) != std::string::npos) {
+                std::string line = buffer.substr(0, newline);
+                buffer.erase(0, newline + 1);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line.empty()) continue;
+                if (line == "stats") {
+                    open = send_line(client, log.summary());
+                } else if (line == "shutdown") {
+                    // La respuesta va antes de avisar al hilo principal, que al
+                    // parar corta todas las conexiones, también esta.
+                    send_line(client, "bye");
+                    stopping = true;
+                    // Desbloquea el accept del hilo principal.
+                    shutdown(server, SHUT_RDWR);
+                    open = false;
+                } else {
+                    open = send_line(client, answer_query(line, memo, log));
+                }
+            }
+        }
+    };
+
+    // Conexiones abiertas; solo el hilo principal toca la lista. El hilo de
+    // cada una marca done al terminar y el descriptor se cierra después del
+    // join, así que el shutdown final nunca cae en un descriptor reutilizado.
+    struct Connection {
+        int client = -1;
+        std::atomic<bool> done{false};
+        std::thread thread;
+    };
+    std::list<Connection> connections;
+    auto reap = [&](bool all) {
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (!all && !it->done) {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            close(it->client);
+            it = connections.erase(it);
+        }
+    };
+
+    bool failed = false;
+    while (!stopping) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (stopping || errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Sin descriptores o sin memoria: se liberan las conexiones
+                // terminadas y se espera un poco en lugar de reintentar sin pausa.
+                reap(false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            failed = true;
+            break;
+        }
+        // Con cada conexión nueva se recogen las que ya han terminado.
+        reap(false);
+        Connection& connection = connections.emplace_back();
+        connection.client = client;
+        connection.thread = std::thread([&handle, &connection] {
+            handle(connection.client);
+            connection.done = true;
+        });
+    }
+    // Las conexiones que siguen abiertas ven el fin de la lectura y terminan,
+    // aunque el cliente no vaya a enviar nada más.
+    for (Connection& connection : connections) {
+        shutdown(connection.client, SHUT_RDWR);
+    }
+    reap(true);
+    close(server);
+    unlink(path.c_str());
+    return !failed;
+}
@@ -5,63 +5,32 @@
 #include <string>
 #include <cmath>
 #include <unordered_map>
-#include <set>
 #include <algorithm>
 #include <limits>
 #include <cstdint>
-struct Coordinate{
-    int x;
-    int y;
-    Coordinate(int i, int j): x(i), y(j){}
-};
-
-void create_anthinodes(std::unordered_map<char,std::vector<Coordinate>>& position_anthenes,std::vector<std::string>& map,char anthenna,int x,int y,std::set<std::pair<int,int>>& overlaps){
-    int x_difference,y_difference,x_pos,y_pos;
-    //lets find if there is any anthenne up this new anthene
-    for(const Coordinate& pos : position_anthenes[anthenna]){
-        overlaps.insert(std::make_pair(x,y));
-        overlaps.insert(std::make_pair(pos.x,pos.y));
-        x_difference = x - pos.x;
-        y_difference = y - pos.y;
-        //anthinode positions
-        x_pos = pos.x - x_difference;
-        y_pos = pos.y - y_difference;
-        while(x_pos >= 0 && y_pos >=0 && x_pos < map.size() && y_pos < map[x_pos].size()){
-            if(map[x_pos][y_pos] == '.'){
-                map[x_pos][y_pos] = '#';
-            }else if (map[x_pos][y_pos] != '#'){
-                overlaps.insert(std::make_pair(x_pos,y_pos));
-            }
-            x_pos = x_pos - x_difference;
-            y_pos = y_pos - y_difference;                    
+#include "day8_grid.h"
+#include "day8_antennas.h"
+#include "day8_rules.h"
+#include "day8_parallel.h"
+#include "day8_sparse.h"
+int main(int argc, char* argv[]) {
+    // ./Day8_parte2 --sparse <archivo> lee solo las coordenadas de las antenas
+    if (argc > 2 && std::string(argv[1]) == "--sparse") {
+        uint64_t result = 0;
+        if (!sparse_resonant_count(argv[2], result)) {
+            std::cerr << "Error opening the file!" << std::endl;
+            return 1;
         }
+        std::cout << "Resultado final: " << result << std::endl;
+        return 0;
     }
-    position_anthenes[anthenna].push_back(Coordinate(x,y));
-    for(int i = x; i < map.size(); i++){
-        for(int j = 0; j < map[x].size(); j++){
-            if(i == x && j <= y) continue;
-            if(map[i][j] == anthenna){
-                overlaps.insert(std::make_pair(x,y));
-                overlaps.insert(std::make_pair(i,j));
-                x_difference = i - x;
-                y_difference = j - y;
-                x_pos = i + x_difference;
-                y_pos = j + y_difference;
-                while(x_pos >= 0 && y_pos >=0 && x_pos < map.size() && y_pos < map[x_pos].size() ){
-                    if(map[x_pos][y_pos] == '.'){
-                        map[x_pos][y_pos] = '#';
-                    }else if (map[x_pos][y_pos] != '#'){
-                        overlaps.insert(std::make_pair(x_pos,y_pos));
-                    } 
-                    x_pos = x_pos + x_difference;
-                    y_pos = y_pos + y_difference;       
-                }
-            }
-        }
+
+    // ./Day8_parte2 --threads N reparte las frecuencias entre N hilos
+    unsigned num_threads = 1;
+    if (argc > 2 && std::string(argv[1]) == "--threads") {
+        num_threads = std::stoul(argv[2]);
     }
-}
 
-int main() {
     std::ifstream file("day8_puzzle.txt");
     if (!file) {
         std::cerr << "Error opening the file!" << std::endl;
@@ -75,26 +44,20 @@ int main() {
     while (std::getline(file, line)) {
         map.push_back(line);
     }      
-    // find all the anthenes and create anthinodes
-    std::unordered_map<char,std::vector<Coordinate>> position_anthenes;
-    //overlaps anthinodes
-    std::set<std::pair<int,int>> overlaps;
-    for (int i = 0; i < map.size(); i++) {
-        for(int j = 0; j < map[i].size(); j++){
-            if(map[i][j] != '.' && map[i][j]!='#'){
-                create_anthinodes(position_anthenes,map,map[i][j],i,j,overlaps);
-            }
-        }
-    }
-    uint64_t result = 0;
-    for(int i = 0; i < map.size(); i++){
-        for(int j = 0; j < map[i].size(); j++){
-            if(map[i][j] == '#'){
-                result++;
-            }
+    // group all the anthenes by frequency in a single pass
+    AntennaIndex position_anthenes = index_antennas(map);
+    int rows = map.size();
+    int cols = map.empty() ? 0 : map[0].size();
+    //anthinodes layer, one bit per cell
+    AntinodeGrid antinodes(rows,cols);
+    if(num_threads > 1){
+        antinodes = solve_parallel(position_anthenes,rows,cols,num_threads,create_resonant_anthinodes);
+    }else{
+        for(const auto& group : position_anthenes){
+            create_resonant_anthinodes(group.second,antinodes);
         }
     }
-    result+=overlaps.size();
+    uint64_t result = antinodes.count();
     std::cout << "Resultado final: " << result << std::endl;
     return 0;
 }
@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+struct Coordinate{
+    int x;
+    int y;
+    Coordinate(int i, int j): x(i), y(j){}
+};
+
+// Antenas agrupadas por frecuencia. Los antinodos solo dependen de los pares
+// dentro de un mismo grupo, así que el trabajo depende del número de antenas
+// y no del tamaño del mapa.
+using AntennaIndex = std::unordered_map<char,std::vector<Coordinate>>;
+
+// Una única pasada por el mapa para indexar todas las antenas.
+inline AntennaIndex index_antennas(const std::vector<std::string>& map){
+    AntennaIndex position_anthenes;
+    for(int i = 0; i < static_cast<int>(map.size()); i++){
+        for(int j = 0; j < static_cast<int>(map[i].size()); j++){
+            char c = map[i][j];
+            if(c != '.' && c != '#'){
+                position_anthenes[c].push_back(Coordinate(i,j));
+            }
+        }
+    }
+    return position_anthenes;
+}
@@ -0,0 +1,129 @@
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include "day8_grid.h"
+#include "day8_antennas.h"
+#include "day8_rules.h"
+#include "day8_parallel.h"
+#include "day8_live.h"
+
+// Benchmarks del día 8. Uso: ./day8_bench [scaling|live] [max_hilos]
+
+// Mapa aleatorio de size x size con "frequencies" frecuencias y
+// "per_frequency" antenas de cada una.
+std::vector<std::string> random_map(int size,int frequencies,int per_frequency,uint32_t seed){
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0,size - 1);
+    std::vector<std::string> map(size,std::string(size,'.'));
+    const std::string symbols = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    for(int f = 0; f < frequencies; f++){
+        for(int k = 0; k < per_frequency; k++){
+            map[coord(rng)][coord(rng)] = symbols[f % symbols.size()];
+        }
+    }
+    return map;
+}
+
+template <typename F>
+double time_ms(F&& f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Escalado de solve_parallel de 1 a max_threads hilos para las dos reglas.
+void bench_scaling(unsigned max_threads){
+    const int size = 2000;
+    std::vector<std::string> map = random_map(size,40,400,42);
+    AntennaIndex position_anthenes = index_antennas(map);
+
+    auto run = [&](const char* name,auto rule){
+        std::cout << "== scaling " << name << " (ms) ==\n";
+        AntinodeGrid serial(size,size);
+        double t_serial = time_ms([&](){
+            for(const auto& group : position_anthenes) rule(group.second,serial,0,SIZE_MAX);
+        });
+        std::cout << "serial\t" << t_serial << "\t" << serial.count() << "\n";
+        for(unsigned threads = 1; threads <= max_threads; threads *= 2){
+            uint64_t count = 0;
+            double t = time_ms([&](){
+                count = solve_parallel(position_anthenes,size,size,threads,rule).count();
+            });
+            if(count != serial.count()) std::cerr << "Error: resultado distinto con " << threads << " hilos" << std::endl;
+            std::cout << threads << "\t" << t << "\tspeedup " << t_serial / t << "\n";
+        }
+    };
+    run("parte1",[](const std::vector<Coordinate>& a,AntinodeGrid& g,size_t first,size_t last){ create_anthinodes(a,g,first,last); });
+    run("parte2",[](const std::vector<Coordinate>& a,AntinodeGrid& g,size_t first,size_t last){ create_resonant_anthinodes(a,g,first,last); });
+}
+
+// Coste de mover una antena con LiveAntinodes frente a recalcular todo.
+void bench_live(){
+    const int size = 2000;
+    std::vector<std::string> map = random_map(size,40,100,7);
+    AntennaIndex position_anthenes = index_antennas(map);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> coord(0,size - 1);
+
+    for(AntinodeRule rule : {AntinodeRule::Pairs,AntinodeRule::Resonant}){
+        const char* name = rule == AntinodeRule::Pairs ? "parte1" : "parte2";
+        std::cout << "== live " << name << " ==\n";
+        LiveAntinodes live(size,size,rule);
+        double t_build = time_ms([&](){
+            for(const auto& group : position_anthenes){
+                for(const Coordinate& c : group.second) live.add_antenna(group.first,c.x,c.y);
+            }
+        });
+
+        auto batch = [&](){
+            AntinodeGrid grid(size,size);
+            for(const auto& group : position_anthenes){
+                if(rule == AntinodeRule::Pairs) create_anthinodes(group.second,grid);
+                else create_resonant_anthinodes(group.second,grid);
+            }
+            return grid.count();
+        };
+        uint64_t expected = 0;
+        double t_batch = time_ms([&](){ expected = batch(); });
+        if(live.count() != expected) std::cerr << "Error: el conteo en vivo no coincide" << std::endl;
+
+        // Mover antenas al azar: quitar y volver a poner en otra celda.
+        const int moves = 2000;
+        double t_moves = time_ms([&](){
+            for(int k = 0; k < moves; k++){
+                auto group = position_anthenes.begin();
+                std::advance(group,k % position_anthenes.size());
+                Coordinate& c = group->second[k % group->second.size()];
+                live.remove_antenna(group->first,c.x,c.y);
+                c = Coordinate(coord(rng),coord(rng));
+                live.add_antenna(group->first,c.x,c.y);
+            }
+        });
+        if(live.count() != batch()) std::cerr << "Error: el conteo tras los movimientos no coincide" << std::endl;
+
+        // Dos antenas de la misma frecuencia en la misma celda no generan
+        // antinodos entre ellas, ni en vivo ni por lotes.
+        auto group = position_anthenes.begin();
+        Coordinate twin = group->second.front();
+        group->second.push_back(twin);
+        live.add_antenna(group->first,twin.x,twin.y);
+        if(live.count() != batch()) std::cerr << "Error: el conteo con antenas coincidentes no coincide" << std::endl;
+        live.remove_antenna(group->first,twin.x,twin.y);
+        group->second.pop_back();
+        std::cout << "build " << t_build << " ms, batch " << t_batch << " ms, move "
+                  << t_moves * 1000.0 / moves << " us\n";
+    }
+}
+
+int main(int argc, char* argv[]){
+    std::string which = argc > 1 ? argv[1] : "all";
+    unsigned max_threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u,std::thread::hardware_concurrency());
+    if(which == "all" || which == "scaling") bench_scaling(max_threads);
+    if(which == "all" || which == "live") bench_live();
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Rejilla de antinodos de un bit por celda, separada de la capa de antenas.
+// Marcar una celda dos veces no cambia nada, así que no hace falta el
+// std::set de solapamientos y el total sale de contar bits (popcount).
+class AntinodeGrid {
+public:
+    AntinodeGrid(int rows, int cols)
+        : rows_(rows), cols_(cols), bits_((static_cast<size_t>(rows) * cols + 63) / 64, 0) {}
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    bool inside(int x, int y) const {
+        return x >= 0 && y >= 0 && x < rows_ && y < cols_;
+    }
+
+    void set(int x, int y) {
+        size_t index = static_cast<size_t>(x) * cols_ + y;
+        bits_[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+
+    bool test(int x, int y) const {
+        size_t index = static_cast<size_t>(x) * cols_ + y;
+        return (bits_[index >> 6] >> (index & 63)) & 1;
+    }
+
+    // Número de celdas marcadas.
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (uint64_t word : bits_) total += __builtin_popcountll(word);
+        return total;
+    }
+
+    // Une otra rejilla del mismo tamaño a esta (OR palabra a palabra).
+    void merge(const AntinodeGrid& other) {
+        for (size_t i = 0; i < bits_.size(); i++) bits_[i] |= other.bits_[i];
+    }
+
+private:
+    int rows_;
+    int cols_;
+    std::vector<uint64_t> bits_;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "day8_antennas.h"
+#include "day8_rules.h"
+#include "../common/flat_coord_map.h"
+
+// Antinodos que se mantienen al día mientras se añaden o quitan antenas.
+// Cada celda guarda cuántos pares la generan; al cambiar una antena solo se
+// recorren los pares en los que participa, sin volver a leer el mapa.
+// Los contadores están en un FlatCoordMap, así que la memoria depende del
+// número de antinodos y no del área del mapa.
+class LiveAntinodes{
+public:
+    LiveAntinodes(int rows,int cols,AntinodeRule rule)
+        : rows_(rows), cols_(cols), rule_(rule) {}
+
+    void add_antenna(char frequency,int x,int y){
+        Coordinate antenna(x,y);
+        std::vector<Coordinate>& anthenes = position_anthenes_[frequency];
+        for(const Coordinate& other : anthenes){
+            visit_pair_antinodes(other,antenna,rows_,cols_,rule_,[&](int i,int j){
+                references_(i,j)++;
+            });
+        }
+        anthenes.push_back(antenna);
+    }
+
+    // Devuelve false si no había ninguna antena de esa frecuencia en (x, y).
+    bool remove_antenna(char frequency,int x,int y){
+        auto group = position_anthenes_.find(frequency);
+        if(group == position_anthenes_.end()) return false;
+        std::vector<Coordinate>& anthenes = group->second;
+        size_t k = 0;
+        while(k < anthenes.size() && !(anthenes[k].x == x && anthenes[k].y == y)) k++;
+        if(k == anthenes.size()) return false;
+
+        Coordinate antenna = anthenes[k];
+        anthenes[k] = anthenes.back();
+        anthenes.pop_back();
+        for(const Coordinate& other : anthenes){
+            visit_pair_antinodes(other,antenna,rows_,cols_,rule_,[&](int i,int j){
+                uint32_t* references = references_.find(i,j);
+                if(--*references == 0) references_.erase(i,j);
+            });
+        }
+        return true;
+    }
+
+    // Número de celdas con al menos un antinodo.
+    uint64_t count() const{ return references_.size(); }
+
+private:
+    int rows_;
+    int cols_;
+    AntinodeRule rule_;
+    FlatCoordMap<uint32_t> references_;
+    AntennaIndex position_anthenes_;
+};
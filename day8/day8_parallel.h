@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "day8_grid.h"
+#include "day8_antennas.h"
+
+// Resolución multihilo del día 8. Las frecuencias son independientes, así que
+// cada grupo (o trozo de un grupo grande) es una tarea. Cada hilo marca en su
+// propia rejilla de bits y al final se unen todas con OR.
+
+// Pares de un grupo cuya primera antena está en [first, last).
+struct PairTask{
+    const std::vector<Coordinate>* anthenes;
+    size_t first;
+    size_t last;
+};
+
+// Divide cada grupo en tareas de unos pairs_per_task pares como mucho.
+// Los pares de la antena a son n - 1 - a, así que los trozos se ajustan
+// acumulando esa cantidad en lugar de repartir índices a partes iguales.
+inline std::vector<PairTask> split_pair_tasks(const AntennaIndex& position_anthenes,size_t pairs_per_task){
+    std::vector<PairTask> tasks;
+    for(const auto& group : position_anthenes){
+        const std::vector<Coordinate>& anthenes = group.second;
+        size_t n = anthenes.size();
+        size_t first = 0, pairs = 0;
+        for(size_t a = 0; a < n; a++){
+            pairs += n - 1 - a;
+            if(pairs >= pairs_per_task || a + 1 == n){
+                tasks.push_back({&anthenes,first,a + 1});
+                first = a + 1;
+                pairs = 0;
+            }
+        }
+    }
+    return tasks;
+}
+
+// Ejecuta rule(anthenes, rejilla, first, last) para todas las tareas con
+// num_threads hilos que van cogiendo la siguiente tarea libre.
+template <typename Rule>
+AntinodeGrid solve_parallel(const AntennaIndex& position_anthenes,int rows,int cols,unsigned num_threads,Rule rule,size_t pairs_per_task = 4096){
+    if(num_threads == 0) num_threads = 1;
+    std::vector<PairTask> tasks = split_pair_tasks(position_anthenes,pairs_per_task);
+    if(num_threads > tasks.size()) num_threads = tasks.empty() ? 1 : static_cast<unsigned>(tasks.size());
+
+    std::vector<AntinodeGrid> local(num_threads,AntinodeGrid(rows,cols));
+    std::atomic<size_t> next_task{0};
+    auto worker = [&](unsigned t){
+        for(size_t k = next_task++; k < tasks.size(); k = next_task++){
+            rule(*tasks[k].anthenes,local[t],tasks[k].first,tasks[k].last);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(unsigned t = 1; t < num_threads; t++){
+        threads.emplace_back(worker,t);
+    }
+    worker(0);
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    for(unsigned t = 1; t < num_threads; t++){
+        local[0].merge(local[t]);
+    }
+    return std::move(local[0]);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "day8_grid.h"
+#include "day8_antennas.h"
+
+// Reglas de antinodos de las dos partes del día 8.
+
+// Regla de cada parte.
+enum class AntinodeRule{ Pairs, Resonant };
+
+// Llama a visit(x, y) por cada antinodo dentro del mapa que genera el par (a, b)
+// con la regla indicada. Cada celda se visita una sola vez por par. Es la
+// única definición de las reglas: las versiones por lotes de abajo y
+// LiveAntinodes la usan, así que todas tratan igual los casos límite.
+template <typename Visit>
+void visit_pair_antinodes(const Coordinate& a,const Coordinate& b,int rows,int cols,AntinodeRule rule,Visit visit){
+    int x_difference = b.x - a.x;
+    int y_difference = b.y - a.y;
+    //two anthenes on the same cell have no line and no antinodes
+    if(x_difference == 0 && y_difference == 0) return;
+    auto inside = [&](int x,int y){ return x >= 0 && y >= 0 && x < rows && y < cols; };
+    if(rule == AntinodeRule::Pairs){
+        if(inside(a.x - x_difference,a.y - y_difference)) visit(a.x - x_difference,a.y - y_difference);
+        if(inside(b.x + x_difference,b.y + y_difference)) visit(b.x + x_difference,b.y + y_difference);
+        return;
+    }
+    for(int x_pos = a.x, y_pos = a.y; inside(x_pos,y_pos); x_pos -= x_difference, y_pos -= y_difference){
+        visit(x_pos,y_pos);
+    }
+    for(int x_pos = b.x, y_pos = b.y; inside(x_pos,y_pos); x_pos += x_difference, y_pos += y_difference){
+        visit(x_pos,y_pos);
+    }
+}
+
+// Antinodos de una frecuencia: por cada par de antenas, un punto a cada lado
+// a la misma distancia que las separa. Solo se procesan los pares cuya primera
+// antena está en [first, last), para poder repartir grupos grandes entre hilos.
+inline void create_anthinodes(const std::vector<Coordinate>& anthenes,AntinodeGrid& antinodes,size_t first = 0,size_t last = SIZE_MAX){
+    last = std::min(last,anthenes.size());
+    for(size_t a = first; a < last; a++){
+        for(size_t b = a + 1; b < anthenes.size(); b++){
+            visit_pair_antinodes(anthenes[a],anthenes[b],antinodes.rows(),antinodes.cols(),AntinodeRule::Pairs,
+                                 [&](int x_pos,int y_pos){ antinodes.set(x_pos,y_pos); });
+        }
+    }
+}
+
+// Antinodos de una frecuencia con armónicos: todos los puntos de la recta que
+// pasa por cada par de antenas, incluidas las propias antenas. Igual que en la
+// parte 1, [first, last) limita la primera antena de cada par.
+inline void create_resonant_anthinodes(const std::vector<Coordinate>& anthenes,AntinodeGrid& antinodes,size_t first = 0,size_t last = SIZE_MAX){
+    last = std::min(last,anthenes.size());
+    for(size_t a = first; a < last; a++){
+        for(size_t b = a + 1; b < anthenes.size(); b++){
+            visit_pair_antinodes(anthenes[a],anthenes[b],antinodes.rows(),antinodes.cols(),AntinodeRule::Resonant,
+                                 [&](int x_pos,int y_pos){ antinodes.set(x_pos,y_pos); });
+        }
+    }
+}
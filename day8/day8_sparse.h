@@ -0,0 +1,111 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include "day8_antennas.h"
+
+// Modo disperso de la parte 2 para mapas enormes (por ejemplo 10^6 x 10^6 con
+// unos miles de antenas). No se guarda el mapa: solo las coordenadas de las
+// antenas, y los antinodos se guardan como celdas empaquetadas x * cols + y.
+//
+// Formato de entrada:
+//   rows cols
+//   <frecuencia> <x> <y>      (una antena por línea)
+
+// Lee el archivo disperso. Devuelve false si no se puede abrir o falta la cabecera.
+inline bool load_sparse_antennas(const std::string& path,int64_t& rows,int64_t& cols,AntennaIndex& position_anthenes){
+    std::ifstream file(path);
+    if(!file || !(file >> rows >> cols)) return false;
+    char frequency;
+    int x,y;
+    while(file >> frequency >> x >> y){
+        if(x >= 0 && y >= 0 && x < rows && y < cols){
+            position_anthenes[frequency].push_back(Coordinate(x,y));
+        }
+    }
+    return true;
+}
+
+// División entera redondeando hacia -infinito y hacia +infinito.
+inline int64_t floor_div(int64_t a,int64_t b){
+    int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+inline int64_t ceil_div(int64_t a,int64_t b){
+    return -floor_div(-a,b);
+}
+
+// Valores de t para los que p + t * step queda dentro de [0, size).
+inline void clip_axis(int64_t p,int64_t step,int64_t size,int64_t& t_min,int64_t& t_max){
+    if(step == 0) return; // p ya está dentro y no se mueve en este eje
+    int64_t lo = step > 0 ? ceil_div(-p,step) : ceil_div(size - 1 - p,step);
+    int64_t hi = step > 0 ? floor_div(size - 1 - p,step) : floor_div(-p,step);
+    t_min = std::max(t_min,lo);
+    t_max = std::min(t_max,hi);
+}
+
+class SparseResonance{
+public:
+    SparseResonance(int64_t rows,int64_t cols,size_t compact_every = size_t(1) << 24)
+        : rows_(rows), cols_(cols), compact_every_(compact_every) {}
+
+    // Puntos a + t * (b - a) de cada par de antenas del grupo, con el mismo paso
+    // que visit_pair_antinodes en el modo denso, para que ambos den lo mismo.
+    // La recta se recorta a los límites del mapa antes de enumerar.
+    void add_group(const std::vector<Coordinate>& anthenes){
+        for(size_t a = 0; a < anthenes.size(); a++){
+            for(size_t b = a + 1; b < anthenes.size(); b++){
+                int64_t dx = anthenes[b].x - anthenes[a].x;
+                int64_t dy = anthenes[b].y - anthenes[a].y;
+                //two anthenes on the same cell have no line
+                if(dx == 0 && dy == 0) continue;
+                int64_t t_min = INT64_MIN, t_max = INT64_MAX;
+                clip_axis(anthenes[a].x,dx,rows_,t_min,t_max);
+                clip_axis(anthenes[a].y,dy,cols_,t_min,t_max);
+                for(int64_t t = t_min; t <= t_max; t++){
+                    points_.push_back(static_cast<uint64_t>(anthenes[a].x + t * dx) * cols_ + (anthenes[a].y + t * dy));
+                }
+                if(points_.size() >= pending_limit()) compact();
+            }
+        }
+    }
+
+    // Número de antinodos distintos.
+    uint64_t count(){
+        compact();
+        return points_.size();
+    }
+
+private:
+    // Ordena y elimina duplicados; la memoria queda proporcional a los antinodos.
+    void compact(){
+        std::sort(points_.begin(),points_.end());
+        points_.erase(std::unique(points_.begin(),points_.end()),points_.end());
+        unique_size_ = points_.size();
+    }
+
+    size_t pending_limit() const{
+        return std::max(compact_every_,2 * unique_size_);
+    }
+
+    int64_t rows_;
+    int64_t cols_;
+    size_t compact_every_;
+    size_t unique_size_ = 0;
+    std::vector<uint64_t> points_;
+};
+
+// Cuenta los antinodos de la parte 2 de un archivo disperso.
+inline bool sparse_resonant_count(const std::string& path,uint64_t& result){
+    int64_t rows,cols;
+    AntennaIndex position_anthenes;
+    if(!load_sparse_antennas(path,rows,cols,position_anthenes)) return false;
+    SparseResonance resonance(rows,cols);
+    for(const auto& group : position_anthenes){
+        resonance.add_group(group.second);
+    }
+    result = resonance.count();
+    return true;
+}